@@ -0,0 +1,121 @@
+// File: bench/bench-aos.cpp
+// Microbenchmarks de las operaciones de imgaos: cada uno se repite para todos los lados
+// y profundidades de formasEntrada e informa de píxeles/s y bytes/s de la entrada.
+#include "entradas.hpp"
+
+#include "../common/binario.hpp"
+#include "../common/escalado.hpp"
+#include "../imgaos/compress.hpp"
+#include "../imgaos/cutfreq.hpp"
+#include "../imgaos/maxlevel.hpp"
+#include "../imgaos/pyramid.hpp"
+#include "../imgaos/resize.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+  constexpr int NUEVO_MAX_8BIT = 127;
+  constexpr int NUEVO_MAX_16BIT = 4095;
+  constexpr int COLORES_CUTFREQ = 1000;
+  constexpr int BITS_16 = 16;
+
+  void BM_Leer(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const std::string & entrada = archivoEntrada(forma);
+    for (auto _ : state) {
+      PPMImage imagen;
+      benchmark::DoNotOptimize(leerImagenPPM(entrada, imagen));
+      benchmark::DoNotOptimize(imagen.pixelData.data());
+    }
+    contarProcesado(state, forma);
+  }
+
+  void BM_Escribir(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const PPMImage imagen = imagenEntrada(forma);
+    const std::string salida = archivoSalida("aos-escribir.ppm");
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(escribirImagenPPM(salida, imagen));
+    }
+    contarProcesado(state, forma);
+  }
+
+  // maxlevel en memoria: cada iteración parte de una copia de la imagen original
+  void BM_Maxlevel(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const PPMImage original = imagenEntrada(forma);
+    const int nuevoMax = (forma.bits == BITS_16) ? NUEVO_MAX_16BIT : NUEVO_MAX_8BIT;
+    for (auto _ : state) {
+      state.PauseTiming();
+      PPMImage imagen = original;
+      state.ResumeTiming();
+      applyMaxLevel(imagen, nuevoMax);
+      benchmark::DoNotOptimize(imagen.pixelData.data());
+    }
+    contarProcesado(state, forma);
+  }
+
+  // resize a la mitad de lado, de archivo a archivo (incluye la lectura y la escritura)
+  void BM_Resize(benchmark::State & state, FiltroEscalado filtro) {
+    const FormaEntrada forma = formaDe(state);
+    const std::string & entrada = archivoEntrada(forma);
+    const std::string salida = archivoSalida("aos-resize.ppm");
+    const SilenciarSalida silencio;
+    for (auto _ : state) {
+      performResizeOperation(entrada, salida, {.width = forma.lado / 2, .height = forma.lado / 2, .filtro = filtro});
+    }
+    contarProcesado(state, forma);
+  }
+
+  void BM_Pyramid(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const std::string & entrada = archivoEntrada(forma);
+    const std::string salida = archivoSalida("aos-pyramid.ppm");
+    const SilenciarSalida silencio;
+    for (auto _ : state) {
+      performPyramidOperation(entrada, salida, 0);
+    }
+    contarProcesado(state, forma);
+  }
+
+  void BM_Cutfreq(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const PPMImage original = imagenEntrada(forma);
+    const SilenciarSalida silencio;
+    for (auto _ : state) {
+      state.PauseTiming();
+      PPMImage imagen = original;
+      state.ResumeTiming();
+      cutfreq(imagen, COLORES_CUTFREQ);
+      benchmark::DoNotOptimize(imagen.pixelData.data());
+    }
+    contarProcesado(state, forma);
+  }
+
+  void BM_Compress(benchmark::State & state) {
+    const FormaEntrada forma = formaDe(state);
+    const common::CompressionPaths rutas{.inputImagePath = archivoEntrada(forma),
+                                         .outputImagePath = archivoSalida("aos-compress.cppm")};
+    const SilenciarSalida silencio;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(common::compress(rutas));
+    }
+    contarProcesado(state, forma);
+  }
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,cert-err58-cpp)
+BENCHMARK(BM_Leer)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK(BM_Escribir)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK(BM_Maxlevel)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Resize, nearest, FiltroEscalado::vecino)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Resize, bilinear, FiltroEscalado::bilineal)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Resize, area, FiltroEscalado::area)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK(BM_Pyramid)->Apply(formasEntrada)->UseRealTime();
+BENCHMARK(BM_Cutfreq)->Apply(formasColores)->UseRealTime();
+BENCHMARK(BM_Compress)->Apply(formasColores)->UseRealTime();
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,cert-err58-cpp)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+// File: bench/bench-parallel.cpp
+// Microbenchmarks del grupo de hilos compartido (common/parallel), sin imágenes: miden el
+// coste de repartir, robar y esperar tareas. El número de hilos se fija una vez por
+// proceso, así que para compararlo se ejecuta con distintos IMTOOL_THREADS; cada
+// resultado lo indica en el contador `threads`.
+#include "../common/parallel.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace {
+  constexpr std::size_t INDICES = std::size_t{1} << 16U;
+  constexpr std::int64_t GRANO_MINIMO = 1;
+  constexpr std::int64_t GRANO_MAXIMO = 4096;
+  constexpr std::int64_t FACTOR_GRANO = 8;
+  constexpr std::int64_t RAMAS = 4;
+  constexpr std::int64_t PROFUNDIDAD_MAXIMA = 5;
+  constexpr std::size_t TAREAS_DESIGUALES = 256;
+  constexpr std::size_t PASOS_POR_TAREA = 64;
+
+  // Granos (0 = automático) para los bucles sobre INDICES
+  void granos(benchmark::internal::Benchmark * b) {
+    b->Arg(0);
+    for (std::int64_t grano = GRANO_MINIMO; grano <= GRANO_MAXIMO; grano *= FACTOR_GRANO) {
+      b->Arg(grano);
+    }
+  }
+
+  void contarIndices(benchmark::State & state, std::size_t indices) {
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices));
+    state.counters["threads"] = static_cast<double>(threadCount());
+  }
+
+  // Trabajo artificial de `pasos` iteraciones que el compilador no puede eliminar
+  void trabajar(std::size_t pasos) {
+    std::uint64_t acumulado = 0;
+    for (std::size_t paso = 0; paso < pasos; ++paso) {
+      acumulado += paso;
+      benchmark::DoNotOptimize(acumulado);
+    }
+  }
+
+  // Cuerpo vacío: solo el coste de repartir los bloques y esperarlos
+  void BM_ParallelForVacio(benchmark::State & state) {
+    const auto grano = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      parallelFor(0, INDICES, grano, [](std::size_t, std::size_t) {});
+    }
+    contarIndices(state, INDICES);
+  }
+
+  // Cuerpo trivial: una operación por índice
+  void BM_ParallelForTrivial(benchmark::State & state) {
+    const auto grano = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+      parallelFor(0, INDICES, grano, [](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          benchmark::DoNotOptimize(i);
+        }
+      });
+    }
+    contarIndices(state, INDICES);
+  }
+
+  // Árbol de RAMAS^profundidad tareas: cada una crea y espera su propio grupo
+  void crearArbol(std::int64_t profundidad, std::atomic<std::size_t> & hojas) {
+    if (profundidad == 0) {
+      hojas.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    TaskGroup grupo;
+    for (std::int64_t rama = 0; rama < RAMAS; ++rama) {
+      grupo.run([profundidad, &hojas] { crearArbol(profundidad - 1, hojas); });
+    }
+    grupo.wait();
+  }
+
+  void BM_TaskGroupAnidado(benchmark::State & state) {
+    std::size_t tareas = 0;
+    for (auto _ : state) {
+      std::atomic<std::size_t> hojas{0};
+      crearArbol(state.range(0), hojas);
+      tareas = hojas.load();
+    }
+    contarIndices(state, tareas);
+  }
+
+  // Carga desigual creada desde un único hilo: la tarea i cuesta i pasos, así que los demás
+  // hilos solo tienen trabajo si roban de la cola del que las crea
+  void BM_RoboDesigual(benchmark::State & state) {
+    for (auto _ : state) {
+      TaskGroup grupo;
+      for (std::size_t tarea = 0; tarea < TAREAS_DESIGUALES; ++tarea) {
+        grupo.run([tarea] { trabajar(tarea * PASOS_POR_TAREA); });
+      }
+      grupo.wait();
+    }
+    contarIndices(state, TAREAS_DESIGUALES);
+  }
+}  // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables,cert-err58-cpp)
+BENCHMARK(BM_ParallelForVacio)->Apply(granos)->UseRealTime();
+BENCHMARK(BM_ParallelForTrivial)->Apply(granos)->UseRealTime();
+BENCHMARK(BM_TaskGroupAnidado)->DenseRange(1, PROFUNDIDAD_MAXIMA)->UseRealTime();
+BENCHMARK(BM_RoboDesigual)->UseRealTime();
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables,cert-err58-cpp)
+
+BENCHMARK_MAIN();
@@ -0,0 +1,97 @@
+// File: bench/entradas.cpp
+#include "entradas.hpp"
+
+#include "../common/sintetico.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+  constexpr int LADO_PEQUENO = 256;
+  constexpr int LADO_MEDIO = 1024;
+  constexpr int LADO_GRANDE = 2048;
+  constexpr int BITS_8 = 8;
+  constexpr int BITS_16 = 16;
+  constexpr int DEGRADADO = 0;
+  constexpr int COLORES_POCOS = 256;
+  constexpr int COLORES_MUCHOS = 16384;
+  constexpr int MAX_VALUE_8BIT = 255;
+  constexpr int MAX_VALUE_16BIT = 65535;
+  constexpr std::size_t COMPONENTES_POR_PIXEL = 3;
+  constexpr uint64_t SEMILLA = 0x9E3779B9U;
+  constexpr int RUIDO_8BIT = 8;  // amplitud del ruido del degradado en unidades de 8 bits
+  constexpr double ZIPF = 1.0;
+
+  std::filesystem::path directorioTemporal() {
+    std::filesystem::path directorio = std::filesystem::temp_directory_path() / "imtool-bench";
+    std::filesystem::create_directories(directorio);
+    return directorio;
+  }
+
+  OpcionesSintetico opcionesEntrada(FormaEntrada forma) {
+    const int maxValue = (forma.bits == BITS_16) ? MAX_VALUE_16BIT : MAX_VALUE_8BIT;
+    return {.atributos = {.width = forma.lado, .height = forma.lado, .maxValue = maxValue},
+            .patron = (forma.colores == DEGRADADO) ? PatronSintetico::degradado : PatronSintetico::paleta,
+            .colores = static_cast<std::size_t>(forma.colores),
+            .zipf = ZIPF,
+            .ruido = RUIDO_8BIT * (maxValue / MAX_VALUE_8BIT),
+            .semilla = SEMILLA};
+  }
+}  // namespace
+
+std::size_t FormaEntrada::pixeles() const {
+  return static_cast<std::size_t>(lado) * static_cast<std::size_t>(lado);
+}
+
+std::size_t FormaEntrada::bytes() const {
+  return pixeles() * COMPONENTES_POR_PIXEL * static_cast<std::size_t>(bits / BITS_8);
+}
+
+void formasEntrada(benchmark::internal::Benchmark * b) {
+  b->ArgsProduct({{LADO_PEQUENO, LADO_MEDIO, LADO_GRANDE}, {BITS_8, BITS_16}, {DEGRADADO}});
+  b->ArgNames({"lado", "bits", "colores"});
+}
+
+void formasColores(benchmark::internal::Benchmark * b) {
+  b->ArgsProduct({{LADO_PEQUENO, LADO_MEDIO}, {BITS_8, BITS_16}, {COLORES_POCOS, COLORES_MUCHOS, DEGRADADO}});
+  b->ArgNames({"lado", "bits", "colores"});
+}
+
+FormaEntrada formaDe(const benchmark::State & state) {
+  return {.lado = static_cast<int>(state.range(0)),
+          .bits = static_cast<int>(state.range(1)),
+          .colores = static_cast<int>(state.range(2))};
+}
+
+PPMImage imagenEntrada(FormaEntrada forma) {
+  return generarImagenSintetica(opcionesEntrada(forma));
+}
+
+const std::string & archivoEntrada(FormaEntrada forma) {
+  static std::map<std::tuple<int, int, int>, std::string> escritos;
+  const auto clave = std::make_tuple(forma.lado, forma.bits, forma.colores);
+  if (const auto encontrado = escritos.find(clave); encontrado != escritos.end()) {
+    return encontrado->second;
+  }
+  const std::string ruta = (directorioTemporal() / ("entrada-" + std::to_string(forma.lado) + "-" +
+                                                    std::to_string(forma.bits) + "-" +
+                                                    std::to_string(forma.colores) + ".ppm")).string();
+  if (!escribirImagenSintetica(ruta, opcionesEntrada(forma))) {
+    throw std::runtime_error("No se pudo escribir la entrada del benchmark: " + ruta);
+  }
+  return escritos.emplace(clave, ruta).first->second;
+}
+
+std::string archivoSalida(const std::string & nombre) {
+  return (directorioTemporal() / nombre).string();
+}
+
+void contarProcesado(benchmark::State & state, FormaEntrada forma) {
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(forma.pixeles()));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(forma.bytes()));
+}
@@ -0,0 +1,90 @@
+// File: bench/entradas.hpp
+#ifndef BENCH_ENTRADAS_HPP
+#define BENCH_ENTRADAS_HPP
+
+#include "../common/binario.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+/**
+ * @brief Imagen de entrada de un benchmark: cuadrada de lado x lado píxeles y con
+ * componentes de `bits` bits (8 o 16). Con `colores` 0 es un degradado con ruido (casi
+ * un color por píxel); si no, una paleta de Zipf con ese número exacto de colores.
+ */
+struct FormaEntrada {
+  int lado;
+  int bits;
+  int colores;
+
+  [[nodiscard]] std::size_t pixeles() const;
+  [[nodiscard]] std::size_t bytes() const;
+};
+
+/**
+ * @brief Lados y profundidades de todas las entradas: añade a `b` el producto de ambos,
+ * siempre con el degradado.
+ */
+void formasEntrada(benchmark::internal::Benchmark * b);
+
+/**
+ * @brief Entradas sin el lado grande y con distinto número de colores, en ambas
+ * profundidades: el coste de cutfreq y compress depende sobre todo de él.
+ */
+void formasColores(benchmark::internal::Benchmark * b);
+
+/**
+ * @brief Forma de la entrada a partir de los argumentos de un benchmark (lado, bits, colores).
+ */
+FormaEntrada formaDe(const benchmark::State & state);
+
+/**
+ * @brief Imagen sintética de la forma pedida, idéntica en cualquier ejecución.
+ */
+PPMImage imagenEntrada(FormaEntrada forma);
+
+/**
+ * @brief Ruta de un archivo temporal con imagenEntrada(forma), escrito la primera vez que se pide.
+ */
+const std::string & archivoEntrada(FormaEntrada forma);
+
+/**
+ * @brief Ruta temporal para la salida de un benchmark.
+ */
+std::string archivoSalida(const std::string & nombre);
+
+/**
+ * @brief Cuenta los píxeles y bytes procesados por todas las iteraciones de `state`, de
+ * modo que el informe muestre píxeles/s (items_per_second) y bytes/s.
+ */
+void contarProcesado(benchmark::State & state, FormaEntrada forma);
+
+/**
+ * @brief Descarta todo lo que se escribe en std::cout mientras existe: las operaciones
+ * informan de su progreso por ahí y ensuciarían la tabla de resultados.
+ */
+class SilenciarSalida {
+  public:
+    SilenciarSalida() : anterior(std::cout.rdbuf(&nulo)) {}
+    SilenciarSalida(const SilenciarSalida &) = delete;
+    SilenciarSalida(SilenciarSalida &&) = delete;
+    SilenciarSalida & operator=(const SilenciarSalida &) = delete;
+    SilenciarSalida & operator=(SilenciarSalida &&) = delete;
+    ~SilenciarSalida() { std::cout.rdbuf(anterior); }
+
+  private:
+    class BufferNulo : public std::streambuf {
+      protected:
+        int_type overflow(int_type caracter) override { return traits_type::not_eof(caracter); }
+    };
+
+    BufferNulo nulo;
+    std::streambuf * anterior;
+};
+
+#endif // BENCH_ENTRADAS_HPP
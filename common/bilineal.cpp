@@ -0,0 +1,256 @@
+// File: common/bilineal.cpp
+#include "bilineal.hpp"
+#include "isa.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(IMTOOL_VARIANTES_X86)
+  #include <immintrin.h>
+#endif
+
+namespace {
+  constexpr std::size_t SIN_FILA = std::numeric_limits<std::size_t>::max();
+
+  // Precisión de la coma fija según el tipo de componente
+  template <typename T>
+  struct Precision;
+
+  template <>
+  struct Precision<uint8_t> {
+    static constexpr unsigned int BITS = BITS_PESO;
+    using Acumulador = uint32_t;
+  };
+
+  template <>
+  struct Precision<uint16_t> {
+    // Un valor de 16 bits por un peso de 16 bits cabe en 32 bits; la pasada vertical acumula en 64
+    static constexpr unsigned int BITS = BITS_PESO_16BIT;
+    using Acumulador = uint64_t;
+  };
+
+  template <typename T>
+  constexpr uint32_t PESO_UNIDAD = uint32_t{1} << Precision<T>::BITS;
+
+  // Fila original ya interpolada horizontalmente, en coma fija
+  struct FilaCacheada {
+    std::vector<uint32_t> valores;
+    std::size_t origen = SIN_FILA;
+  };
+
+  // Dos filas interpoladas horizontalmente y el peso de la segunda
+  struct FilasVecinas {
+    std::span<uint32_t const> arriba;
+    std::span<uint32_t const> abajo;
+    uint32_t peso;
+  };
+
+  // Pasada horizontal: interpola todos los componentes de una fila original
+  template <typename T>
+  [[gnu::always_inline]] inline void interpolarFilaHorizontal(std::span<uint8_t const> origen, std::span<uint32_t> destino,
+                                TablaEje const & tablaX, std::size_t canales) {
+    for (std::size_t x = 0; x < tablaX.peso.size(); ++x) {
+      const std::size_t bajo = tablaX.bajo[x] * canales;
+      const std::size_t alto = tablaX.alto[x] * canales;
+      const uint32_t peso = tablaX.peso[x];
+      for (std::size_t canal = 0; canal < canales; ++canal) {
+        destino[(x * canales) + canal] = (leerComponente<T>(origen, bajo + canal) * (PESO_UNIDAD<T> - peso)) +
+                                         (leerComponente<T>(origen, alto + canal) * peso);
+      }
+    }
+  }
+
+  // Pasada vertical escalar para los componentes [inicio, filas.arriba.size())
+  template <typename T>
+  [[gnu::always_inline]] inline void interpolarFilasVerticalEscalar(FilasVecinas const & filas, std::span<uint8_t> destino,
+                                      std::size_t inicio) {
+    using Acumulador = typename Precision<T>::Acumulador;
+    constexpr unsigned int DESPLAZAMIENTO_FINAL = 2 * Precision<T>::BITS;
+    const Acumulador pesoArriba = PESO_UNIDAD<T> - filas.peso;
+    for (std::size_t i = inicio; i < filas.arriba.size(); ++i) {
+      const Acumulador suma = (Acumulador{filas.arriba[i]} * pesoArriba) + (Acumulador{filas.abajo[i]} * filas.peso);
+      escribirComponente<T>(destino, i, static_cast<uint32_t>(suma >> DESPLAZAMIENTO_FINAL));
+    }
+  }
+
+#if defined(IMTOOL_VARIANTES_X86)
+  constexpr std::size_t BLOQUE_AVX2 = 16;
+  constexpr std::size_t MITAD_AVX2 = 8;
+
+  // Combina 8 componentes de 8 bits de cada fila y devuelve los 8 resultados de 32 bits
+  IMTOOL_DESTINO_AVX2 __m256i combinarOcho(uint32_t const * arriba, uint32_t const * abajo, __m256i pesoArriba,
+                       __m256i pesoAbajo) {
+    constexpr unsigned int DESPLAZAMIENTO_FINAL = 2 * BITS_PESO;
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i valoresArriba = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(arriba));
+    const __m256i valoresAbajo = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(abajo));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i suma = _mm256_add_epi32(_mm256_mullo_epi32(valoresArriba, pesoArriba),
+                                          _mm256_mullo_epi32(valoresAbajo, pesoAbajo));
+    return _mm256_srli_epi32(suma, DESPLAZAMIENTO_FINAL);
+  }
+
+  // Combina 8 componentes de 16 bits de cada fila con productos de 64 bits (carriles pares
+  // e impares por separado) y devuelve los 8 resultados de 32 bits
+  IMTOOL_DESTINO_AVX2 __m256i combinarOcho16(uint32_t const * arriba, uint32_t const * abajo, __m256i pesoArriba,
+                         __m256i pesoAbajo) {
+    constexpr int BITS_CARRIL = 32;
+    constexpr int CARRILES_IMPARES = 0xAA;
+    // Desplazar 32 bits deja el resultado en la mitad alta (impares) o, tras bajarla, en la baja (pares)
+    static_assert(2 * BITS_PESO_16BIT == BITS_CARRIL);
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i valoresArriba = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(arriba));
+    const __m256i valoresAbajo = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(abajo));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i pares = _mm256_add_epi64(_mm256_mul_epu32(valoresArriba, pesoArriba),
+                                           _mm256_mul_epu32(valoresAbajo, pesoAbajo));
+    const __m256i impares =
+        _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(valoresArriba, BITS_CARRIL), pesoArriba),
+                         _mm256_mul_epu32(_mm256_srli_epi64(valoresAbajo, BITS_CARRIL), pesoAbajo));
+    return _mm256_blend_epi32(_mm256_srli_epi64(pares, BITS_CARRIL), impares, CARRILES_IMPARES);
+  }
+
+  // Estrecha 16 resultados de 32 bits a 8 bits
+  IMTOOL_DESTINO_AVX2 void guardarBloque(__m256i primero, __m256i segundo, uint8_t * destino) {
+    // Reúne los bytes útiles de cada carril de 128 bits tras los empaquetados
+    const __m256i orden = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i palabras = _mm256_packus_epi32(primero, segundo);
+    const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(palabras, palabras), orden);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(destino), _mm256_castsi256_si128(bytes));
+  }
+
+  // Estrecha 16 resultados de 32 bits a 16 bits (byte bajo primero)
+  IMTOOL_DESTINO_AVX2 void guardarBloque16(__m256i primero, __m256i segundo, uint8_t * destino) {
+    constexpr int ORDEN_CARRILES = 0xD8;  // carriles de 64 bits en orden 0, 2, 1, 3
+    const __m256i palabras = _mm256_permute4x64_epi64(_mm256_packus_epi32(primero, segundo), ORDEN_CARRILES);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(destino), palabras);
+  }
+
+  // Pasada vertical con AVX2: 16 componentes por iteración. Devuelve el número de componentes procesados.
+  template <typename T>
+  IMTOOL_DESTINO_AVX2 std::size_t interpolarFilasVerticalAvx2(FilasVecinas const & filas, std::span<uint8_t> destino) {
+    constexpr bool ES_8BIT = std::is_same_v<T, uint8_t>;
+    const __m256i pesoArriba = _mm256_set1_epi32(static_cast<int>(PESO_UNIDAD<T> - filas.peso));
+    const __m256i pesoAbajo = _mm256_set1_epi32(static_cast<int>(filas.peso));
+    const auto combinar = ES_8BIT ? combinarOcho : combinarOcho16;
+    const auto guardar = ES_8BIT ? guardarBloque : guardarBloque16;
+
+    std::size_t i = 0;
+    for (; i + BLOQUE_AVX2 <= filas.arriba.size(); i += BLOQUE_AVX2) {
+      const __m256i primero = combinar(&filas.arriba[i], &filas.abajo[i], pesoArriba, pesoAbajo);
+      const __m256i segundo =
+          combinar(&filas.arriba[i + MITAD_AVX2], &filas.abajo[i + MITAD_AVX2], pesoArriba, pesoAbajo);
+      guardar(primero, segundo, &destino[i * sizeof(T)]);
+    }
+    return i;
+  }
+#endif
+
+  // Pasada vertical: combina dos filas ya interpoladas horizontalmente. ConAvx2 solo
+  // se activa en las variantes compiladas para AVX2 o AVX-512.
+  template <typename T, bool ConAvx2>
+  [[gnu::always_inline]] inline void interpolarFilasVertical(FilasVecinas const & filas,
+                                                             std::span<uint8_t> destino) {
+    std::size_t inicio = 0;
+#if defined(IMTOOL_VARIANTES_X86)
+    if constexpr (ConAvx2) {
+      inicio = interpolarFilasVerticalAvx2<T>(filas, destino);
+    }
+#endif
+    interpolarFilasVerticalEscalar<T>(filas, destino, inicio);
+  }
+
+  template <typename T>
+  [[gnu::always_inline]] inline void prepararFila(FilaCacheada & fila, std::size_t origen, PlanoOrigen const & plano,
+                    TablaEje const & tablaX) {
+    if (fila.origen != origen) {
+      interpolarFilaHorizontal<T>(filaOrigen(plano, origen), fila.valores, tablaX, plano.canales);
+      fila.origen = origen;
+    }
+  }
+
+  // Escala un rango de filas del destino con su propia caché de filas
+  template <typename T, bool ConAvx2>
+  [[gnu::always_inline]] inline void escalarFranjaCuerpo(PlanoOrigen const & origen, PlanoDestino const & destino,
+                     TablasEscalado const & tablas, RangoFilas filas) {
+    const std::size_t componentes = destino.width * origen.canales;
+    FilaCacheada baja{.valores = std::vector<uint32_t>(componentes)};
+    FilaCacheada alta{.valores = std::vector<uint32_t>(componentes)};
+
+    for (std::size_t y = filas.inicio; y < filas.fin; ++y) {
+      // Al avanzar, la fila alta anterior suele ser la fila baja actual
+      if (alta.origen == tablas.y.bajo[y] && baja.origen != tablas.y.bajo[y]) {
+        std::swap(baja, alta);
+      }
+      prepararFila<T>(baja, tablas.y.bajo[y], origen, tablas.x);
+      prepararFila<T>(alta, tablas.y.alto[y], origen, tablas.x);
+      const FilasVecinas vecinas{.arriba = baja.valores, .abajo = alta.valores, .peso = tablas.y.peso[y]};
+      interpolarFilasVertical<T, ConAvx2>(vecinas, filaDestino(destino, y, componentes * sizeof(T)));
+    }
+  }
+
+  // Variantes por nivel de instrucciones (isa.hpp) de la franja completa
+  using NucleoFranja = void (*)(PlanoOrigen const &, PlanoDestino const &, TablasEscalado const &, RangoFilas);
+
+  template <typename T>
+  void escalarFranjaBase(PlanoOrigen const & origen, PlanoDestino const & destino, TablasEscalado const & tablas,
+                         RangoFilas filas) {
+    escalarFranjaCuerpo<T, false>(origen, destino, tablas, filas);
+  }
+
+  template <typename T>
+  IMTOOL_DESTINO_AVX2 void escalarFranjaAvx2(PlanoOrigen const & origen, PlanoDestino const & destino,
+                                             TablasEscalado const & tablas, RangoFilas filas) {
+    escalarFranjaCuerpo<T, true>(origen, destino, tablas, filas);
+  }
+
+  template <typename T>
+  IMTOOL_DESTINO_AVX512 void escalarFranjaAvx512(PlanoOrigen const & origen, PlanoDestino const & destino,
+                                                 TablasEscalado const & tablas, RangoFilas filas) {
+    escalarFranjaCuerpo<T, true>(origen, destino, tablas, filas);
+  }
+
+  template <typename T>
+  constexpr VariantesISA<NucleoFranja> ESCALAR_FRANJA{
+      .base = &escalarFranjaBase<T>, .avx2 = &escalarFranjaAvx2<T>, .avx512 = &escalarFranjaAvx512<T>};
+}  // namespace
+
+TablaEje calcularTablaEje(int tamanoOriginal, int tamanoNuevo, std::size_t bytesPorComponente) {
+  const auto nuevo = static_cast<std::size_t>(tamanoNuevo);
+  const double unidad = (bytesPorComponente == 1) ? PESO_UNIDAD<uint8_t> : PESO_UNIDAD<uint16_t>;
+  TablaEje tabla{.bajo = std::vector<std::size_t>(nuevo), .alto = std::vector<std::size_t>(nuevo),
+                 .peso = std::vector<uint32_t>(nuevo)};
+  for (int i = 0; i < tamanoNuevo; ++i) {
+    const double coordenada =
+        (tamanoNuevo > 1) ? static_cast<double>(i) * (tamanoOriginal - 1) / (tamanoNuevo - 1) : 0.0;
+    const int bajo = std::clamp(static_cast<int>(std::floor(coordenada)), 0, tamanoOriginal - 1);
+    const int alto = std::clamp(static_cast<int>(std::ceil(coordenada)), 0, tamanoOriginal - 1);
+    const auto indice = static_cast<std::size_t>(i);
+    tabla.bajo[indice] = static_cast<std::size_t>(bajo);
+    tabla.alto[indice] = static_cast<std::size_t>(alto);
+    tabla.peso[indice] = static_cast<uint32_t>(std::lround((coordenada - bajo) * unidad));
+  }
+  return tabla;
+}
+
+void escalarPlanoBilineal(PlanoOrigen const & origen, PlanoDestino const & destino,
+                          TablasEscalado const & tablas, RangoFilas filas) {
+  const std::size_t componentes = destino.width * origen.canales;
+  const NucleoFranja escalarFranja = (origen.bytesPorComponente == 1) ? elegirVariante(ESCALAR_FRANJA<uint8_t>)
+                                                                       : elegirVariante(ESCALAR_FRANJA<uint16_t>);
+  // Cada hilo recibe una franja de filas de destino y lee solo las filas de origen que la cubren
+  parallelForRows(filas.fin - filas.inicio, componentes, [&](std::size_t primera, std::size_t ultima) {
+    const RangoFilas franja{.inicio = filas.inicio + primera, .fin = filas.inicio + ultima};
+    escalarFranja(origen, destino, tablas, franja);
+  });
+}
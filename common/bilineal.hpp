@@ -0,0 +1,68 @@
+// File: common/bilineal.hpp
+#ifndef BILINEAL_HPP
+#define BILINEAL_HPP
+
+#include "plano.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bits fraccionarios de los pesos en coma fija (pesos entre 0 y 1 << BITS_PESO).
+ *
+ * Con 12 bits por eje, un componente de 8 bits por los dos pesos cabe en 32 bits sin signo.
+ */
+constexpr unsigned int BITS_PESO = 12;
+
+/**
+ * @brief Bits fraccionarios de los pesos para componentes de 16 bits.
+ *
+ * Un componente de 16 bits por un peso cabe en 32 bits sin signo; la pasada vertical
+ * acumula en 64 bits.
+ */
+constexpr unsigned int BITS_PESO_16BIT = 16;
+
+/**
+ * @brief Coeficientes de interpolación de un eje, calculados una sola vez por imagen.
+ *
+ * Para cada índice de salida guarda los dos índices vecinos en la imagen original
+ * y el peso del segundo de ellos en coma fija.
+ */
+struct TablaEje {
+  std::vector<std::size_t> bajo;
+  std::vector<std::size_t> alto;
+  std::vector<uint32_t> peso;
+};
+
+/**
+ * @brief Calcula la tabla de un eje que pasa de tamanoOriginal a tamanoNuevo elementos.
+ *
+ * Los extremos de ambos ejes coinciden; un eje de salida de un solo elemento toma
+ * el primer elemento original. Los pesos usan BITS_PESO o BITS_PESO_16BIT bits
+ * fraccionarios según bytesPorComponente.
+ */
+TablaEje calcularTablaEje(int tamanoOriginal, int tamanoNuevo, std::size_t bytesPorComponente);
+
+/**
+ * @brief Tablas de los dos ejes de un escalado bilineal.
+ */
+struct TablasEscalado {
+  const TablaEje& x;
+  const TablaEje& y;
+};
+
+/**
+ * @brief Escala las filas `filas` de un plano con interpolación bilineal separable.
+ *
+ * Primero interpola horizontalmente cada fila original necesaria (una sola vez por
+ * fila, guardándola en caché) y después combina verticalmente las dos filas
+ * vecinas de cada fila de salida. Toda la aritmética es entera, con los mismos
+ * núcleos para componentes de 8 y 16 bits; la pasada vertical usa AVX2 cuando el
+ * compilador lo tiene disponible. Las filas de salida se reparten en franjas entre
+ * los hilos del grupo compartido, cada una con su propia caché.
+ */
+void escalarPlanoBilineal(const PlanoOrigen& origen, const PlanoDestino& destino,
+                          const TablasEscalado& tablas, RangoFilas filas);
+
+#endif // BILINEAL_HPP
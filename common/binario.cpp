@@ -1,14 +1,25 @@
 // File: common/binario.cpp
 #include "binario.hpp"
 
+#include "estadisticas.hpp"
+#include "nucleos.hpp"
+#include "reserva.hpp"
+
 #include <bit>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <span>
 #include <vector>
 #include <ostream>
 #include <istream>
 #include <cstring>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// Los componentes de 16 bits se guardan en memoria con el byte bajo primero
+static_assert(std::endian::native == std::endian::little, "Solo se admiten plataformas little-endian");
 
 namespace {
     constexpr std::streamsize MAX_HEADER_SIZE = 256;
@@ -16,8 +27,10 @@ namespace {
     constexpr std::size_t COMPONENTS_PER_PIXEL = 3U;
     constexpr int BYTE_COLOR_LIMIT = 256;
     constexpr int SHORT_COLOR_LIMIT = 65536;
+    constexpr std::size_t BYTES_POR_FRANJA = std::size_t{1} << 22U;  // 4 MiB por franja de escritura
 
     bool leerEncabezadoPPM(std::ifstream& file, PPMImage& image) {
+        const FaseMedida fase{"header"};
         std::string magicNumber;
         file >> magicNumber;
         if (magicNumber != "P6") {
@@ -31,6 +44,7 @@ namespace {
     }
 
     bool leerEncabezadoPPMSoA(std::ifstream& file, PPMImageSoA& image) {
+        const FaseMedida fase{"header"};
         std::string magicNumber;
         file >> magicNumber;
         if (magicNumber != "P6") {
@@ -43,12 +57,6 @@ namespace {
         return true;
     }
 
-    void swapBytes(std::vector<unsigned char>& data) {
-        for (std::size_t i = 0; i < data.size(); i += 2) {
-            std::swap(data[i], data[i + 1]);
-        }
-    }
-
     std::size_t calcularTotalBytes(int width, int height, int bytesPerComponent) {
         return static_cast<std::size_t>(width) *
                static_cast<std::size_t>(height) *
@@ -56,59 +64,114 @@ namespace {
                static_cast<std::size_t>(bytesPerComponent);
     }
 
+    std::size_t bytesComponente(int maxValue) {
+        return (maxValue <= MAX_8BIT_VALUE) ? 1 : 2;
+    }
+
+    // Fila y de los tres planos de una imagen SOA como bytes, en el almacenamiento de su profundidad
+    PlanosRGB filaPlanos(PPMImageSoA& image, std::size_t y) {
+        if (image.maxValue > MAX_8BIT_VALUE) {
+            PlanosAlineados<uint16_t>& planos = image.planos16;
+            return {bytesDe(planos.fila(0, y)), bytesDe(planos.fila(1, y)), bytesDe(planos.fila(2, y))};
+        }
+        return {image.planos.fila(0, y), image.planos.fila(1, y), image.planos.fila(2, y)};
+    }
+
+    PlanosRGBConst filaPlanos(const PPMImageSoA& image, std::size_t y) {
+        if (image.maxValue > MAX_8BIT_VALUE) {
+            const PlanosAlineados<uint16_t>& planos = image.planos16;
+            return {bytesDe(planos.fila(0, y)), bytesDe(planos.fila(1, y)), bytesDe(planos.fila(2, y))};
+        }
+        return {image.planos.fila(0, y), image.planos.fila(1, y), image.planos.fila(2, y)};
+    }
+
+    // Bytes de una fila intercalada (en el archivo) de una imagen SOA
+    std::size_t bytesFilaIntercalada(const PPMImageSoA& image) {
+        return static_cast<std::size_t>(image.width) * COMPONENTS_PER_PIXEL * bytesComponente(image.maxValue);
+    }
+
+    // Los planos tienen relleno al final de cada fila, así que se separan e intercalan fila a fila
+    void separarFilas(std::span<const uint8_t> intercalado, PPMImageSoA& image) {
+        const std::size_t bytesFila = bytesFilaIntercalada(image);
+        for (std::size_t y = 0; y < static_cast<std::size_t>(image.height); ++y) {
+            separarCanales(intercalado.subspan(y * bytesFila, bytesFila), filaPlanos(image, y),
+                           bytesComponente(image.maxValue));
+        }
+    }
+
+    // Intercala las filas [rowBegin, rowEnd) en destino
+    void intercalarFilas(const PPMImageSoA& image, std::span<uint8_t> destino, std::size_t rowBegin,
+                         std::size_t rowEnd) {
+        const std::size_t bytesFila = bytesFilaIntercalada(image);
+        for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+            intercalarCanales(filaPlanos(image, y), destino.subspan((y - rowBegin) * bytesFila, bytesFila),
+                              bytesComponente(image.maxValue));
+        }
+    }
+
     bool leerDatosPixeles(std::ifstream& file, PPMImage& image, int bytesPerComponent) {
         const std::size_t totalBytes = calcularTotalBytes(image.width, image.height, bytesPerComponent);
-        image.pixelData.resize(totalBytes);
-
-        if (!file.read(std::bit_cast<char*>(image.pixelData.data()),
-                      static_cast<std::streamsize>(totalBytes))) {
-            std::cerr << "Error al leer los datos de la imagen.\n";
-            return false;
+        if (bytesPerComponent == 2) {
+            image.pixelData16.resize(totalBytes / 2);
+        } else {
+            image.pixelData.resize(totalBytes);
+        }
+        const std::span<uint8_t> datos = (bytesPerComponent == 2) ? bytesDe(image.pixelData16) : bytesDe(image.pixelData);
+
+        {
+            const FaseMedida fase{"read"};
+            if (!file.read(std::bit_cast<char*>(datos.data()), static_cast<std::streamsize>(totalBytes))) {
+                std::cerr << "Error al leer los datos de la imagen.\n";
+                return false;
+            }
         }
 
         if (bytesPerComponent == 2) {
-            swapBytes(image.pixelData);
+            const FaseMedida fase{"convert"};
+            intercambiarBytes16(datos);
         }
         return true;
     }
 
+  // Si quedan al menos bytesCuerpo bytes tras la cabecera; deja el archivo donde estaba.
+  // La lectura por filas lo comprueba al abrir, antes de que se cree la salida, para no
+  // dejar un archivo a medio escribir si la entrada está truncada
+  bool cuerpoCompleto(std::ifstream& file, std::size_t bytesCuerpo) {
+    const std::streampos inicioCuerpo = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff restantes = file.tellg() - inicioCuerpo;
+    file.seekg(inicioCuerpo);
+    return file.good() && restantes >= static_cast<std::streamoff>(bytesCuerpo);
+  }
+
   // Leer datos de píxeles en formato SOA
   bool leerDatosPixelesSoA(std::ifstream& file, PPMImageSoA& image, int bytesPerComponent) {
-    const std::size_t totalPixels = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height);
-
-    // Redimensionar los canales RGB
-    image.redChannel.resize(totalPixels * static_cast<std::size_t>(bytesPerComponent));
-    image.greenChannel.resize(totalPixels * static_cast<std::size_t>(bytesPerComponent));
-    image.blueChannel.resize(totalPixels * static_cast<std::size_t>(bytesPerComponent));
+    const auto width = static_cast<std::size_t>(image.width);
+    const auto height = static_cast<std::size_t>(image.height);
 
-    // Crear un búfer intermedio para leer cada componente de color
-    std::vector<char> buffer(totalPixels * COMPONENTS_PER_PIXEL * static_cast<std::size_t>(bytesPerComponent));
-
-    if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
-        std::cerr << "Error al leer los datos de la imagen.\n";
-        return false;
+    // Reservar los planos RGB de la profundidad de la imagen
+    if (bytesPerComponent == 2) {
+        image.planos16 = PlanosAlineados<uint16_t>(width, height);
+    } else {
+        image.planos = PlanosAlineados<uint8_t>(width, height);
     }
 
-    // Copiar los datos desde el búfer intermedio a los canales RGB
-    for (std::size_t i = 0; i < totalPixels; ++i) {
-        std::memcpy(&image.redChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    &buffer[i * COMPONENTS_PER_PIXEL * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
-        std::memcpy(&image.greenChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    &buffer[(i * COMPONENTS_PER_PIXEL + 1) * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
-        std::memcpy(&image.blueChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    &buffer[(i * COMPONENTS_PER_PIXEL + 2) * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
-    }
+    // Crear un búfer intermedio para leer los píxeles intercalados, reciclado entre imágenes
+    std::pmr::vector<uint8_t> buffer(calcularTotalBytes(image.width, image.height, bytesPerComponent),
+                                     recursoReserva());
 
-    // Si es de 16 bits, hacer el intercambio de bytes
-    if (bytesPerComponent == 2) {
-        swapBytes(image.redChannel);
-        swapBytes(image.greenChannel);
-        swapBytes(image.blueChannel);
+    {
+        const FaseMedida fase{"read"};
+        if (!file.read(std::bit_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+            std::cerr << "Error al leer los datos de la imagen.\n";
+            return false;
+        }
     }
 
+    // Repartir los componentes en los canales RGB, pasando los de 16 bits al orden nativo
+    const FaseMedida fase{"convert"};
+    separarFilas(buffer, image);
+
     return true;
 }
 
@@ -127,39 +190,36 @@ namespace {
         const std::size_t totalBytes = calcularTotalBytes(image.width, image.height, bytesPerComponent);
 
         if (bytesPerComponent == 2) {
-            std::vector<unsigned char> tempData = image.pixelData;
-            swapBytes(tempData);
+            std::pmr::vector<unsigned char> tempData(totalBytes, recursoReserva());
+            {
+                const FaseMedida fase{"serialize"};
+                copiarIntercambiando16(bytesDe(image.pixelData16), tempData);
+            }
+            const FaseMedida fase{"write"};
             return file.write(std::bit_cast<const char*>(tempData.data()),
                             static_cast<std::streamsize>(totalBytes)).good();
         }
 
+        const FaseMedida fase{"write"};
         return file.write(std::bit_cast<const char*>(image.pixelData.data()),
                          static_cast<std::streamsize>(totalBytes)).good();
     }
 
   // Escribir datos de píxeles en formato SOA sin reinterpret_cast
   bool escribirDatosPixelesSoA(std::ofstream& file, const PPMImageSoA& image, int bytesPerComponent) {
-      const std::size_t totalPixels = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height);
-      const std::size_t totalBytesPerChannel = totalPixels * static_cast<std::size_t>(bytesPerComponent);
-
       // Crear un búfer intermedio para almacenar los datos RGB en formato binario
-      std::vector<char> buffer(totalBytesPerChannel * COMPONENTS_PER_PIXEL);
+      std::pmr::vector<uint8_t> buffer(calcularTotalBytes(image.width, image.height, bytesPerComponent),
+                                       recursoReserva());
 
-      // Copiar los datos de los canales RGB al búfer intermedio
-      for (std::size_t i = 0; i < totalPixels; ++i) {
-        std::memcpy(&buffer[i * COMPONENTS_PER_PIXEL * static_cast<std::size_t>(bytesPerComponent)],
-                    &image.redChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
-        std::memcpy(&buffer[(i * COMPONENTS_PER_PIXEL + 1) * static_cast<std::size_t>(bytesPerComponent)],
-                    &image.greenChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
-        std::memcpy(&buffer[(i * COMPONENTS_PER_PIXEL + 2) * static_cast<std::size_t>(bytesPerComponent)],
-                    &image.blueChannel[i * static_cast<std::size_t>(bytesPerComponent)],
-                    static_cast<std::size_t>(bytesPerComponent));
+      // Intercalar los canales RGB en el búfer, con los componentes de 16 bits en el orden del archivo
+      {
+        const FaseMedida fase{"serialize"};
+        intercalarFilas(image, buffer, 0, static_cast<std::size_t>(image.height));
       }
 
       // Escribir el búfer intermedio en el archivo
-      if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+      const FaseMedida fase{"write"};
+      if (!file.write(std::bit_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
         std::cerr << "Error al escribir los datos de la imagen.\n";
         return false;
       }
@@ -181,16 +241,19 @@ namespace {
   }
 
   bool leerDatosTablaColores(std::ifstream& file, PPMImage& image, size_t uniqueColorCount) {
-      const size_t colorSize = (image.maxValue <= MAX_8BIT_VALUE) ? 3U : 6U;
-      image.pixelData.resize(uniqueColorCount * colorSize);
-
-      // Leer datos binarios de colores usando std::memcpy en lugar de reinterpret_cast
-      std::vector<char> buffer(uniqueColorCount * colorSize);
-      if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+      // Los componentes de la tabla van con el byte bajo primero, el orden nativo
+      const std::size_t componentes = uniqueColorCount * COMPONENTS_PER_PIXEL;
+      if (image.maxValue > MAX_8BIT_VALUE) {
+          image.pixelData16.resize(componentes);
+      } else {
+          image.pixelData.resize(componentes);
+      }
+      const std::span<uint8_t> tabla =
+          (image.maxValue > MAX_8BIT_VALUE) ? bytesDe(image.pixelData16) : bytesDe(image.pixelData);
+      if (!file.read(std::bit_cast<char*>(tabla.data()), static_cast<std::streamsize>(tabla.size()))) {
           std::cerr << "Error al leer la tabla de colores.\n";
           return false;
       }
-      std::memcpy(image.pixelData.data(), buffer.data(), buffer.size());
       return true;
   }
 
@@ -218,6 +281,30 @@ namespace {
       return true;
   }
 
+    // Escribe el cuerpo de la imagen franja a franja usando un único búfer intermedio
+    bool escribirFranjas(std::ofstream& file, const PPMAttributes& attrs, const ProductorFilas& productor) {
+        const int bytesPerComponent = (attrs.maxValue <= MAX_8BIT_VALUE) ? 1 : 2;
+        const std::size_t bytesPorFila = calcularTotalBytes(attrs.width, 1, bytesPerComponent);
+        const auto filas = static_cast<std::size_t>(attrs.height);
+        if (bytesPorFila == 0 || filas == 0) {
+            return true;
+        }
+
+        const std::size_t filasPorFranja = std::max<std::size_t>(1, BYTES_POR_FRANJA / bytesPorFila);
+        std::pmr::vector<uint8_t> franja(std::min(filasPorFranja, filas) * bytesPorFila, recursoReserva());
+        for (std::size_t inicio = 0; inicio < filas; inicio += filasPorFranja) {
+            const std::size_t fin = std::min(inicio + filasPorFranja, filas);
+            const std::span<uint8_t> destino{franja.data(), (fin - inicio) * bytesPorFila};
+            productor(destino, inicio, fin);
+            const FaseMedida fase{"write"};
+            if (!file.write(std::bit_cast<const char*>(destino.data()),
+                            static_cast<std::streamsize>(destino.size()))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // Función genérica para escribir un solo valor en binario
     template <typename T>
     void write_binary(std::ostream& output, const T& value) {
@@ -328,6 +415,77 @@ bool escribirImagenPPMSoA(const std::string& filePath, const PPMImageSoA& image)
     }
 }
 
+bool escribirImagenPPMPorFilas(const std::string& filePath, const PPMAttributes& attrs,
+                               const ProductorFilas& productor) {
+    try {
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error al abrir el archivo para escritura: " << filePath << '\n';
+            return false;
+        }
+
+        file << "P6\n" << attrs.width << " " << attrs.height << "\n" << attrs.maxValue << "\n";
+        if (!file.good()) {
+            std::cerr << "Error al escribir el encabezado de la imagen.\n";
+            return false;
+        }
+
+        if (!escribirFranjas(file, attrs, productor)) {
+            std::cerr << "Error al escribir los datos de la imagen.\n";
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error al escribir imagen PPM: " << e.what() << '\n';
+        return false;
+    }
+}
+
+bool escribirImagenPPMSoAPorFilas(const std::string& filePath, const PPMImageSoA& image) {
+    const PPMAttributes attrs{.width = image.width, .height = image.height, .maxValue = image.maxValue};
+    return escribirImagenPPMPorFilas(filePath, attrs,
+                                     [&image](std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd) {
+                                         const FaseMedida fase{"serialize"};
+                                         intercalarFilas(image, destino, rowBegin, rowEnd);
+                                     });
+}
+
+bool LectorPPMPorFilas::abrir(const std::string& filePath) {
+    file.open(filePath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error al abrir el archivo para lectura: " << filePath << '\n';
+        return false;
+    }
+    PPMImage cabecera;
+    if (!leerEncabezadoPPM(file, cabecera)) {
+        return false;
+    }
+    attrs = PPMAttributes{.width = cabecera.width, .height = cabecera.height, .maxValue = cabecera.maxValue};
+    if (!cuerpoCompleto(file, bytesPorFila() * static_cast<std::size_t>(attrs.height))) {
+        std::cerr << "Error al leer los datos de la imagen: el archivo está truncado.\n";
+        return false;
+    }
+    return true;
+}
+
+const PPMAttributes& LectorPPMPorFilas::atributos() const {
+    return attrs;
+}
+
+std::size_t LectorPPMPorFilas::bytesPorFila() const {
+    const int bytesPerComponent = (attrs.maxValue <= MAX_8BIT_VALUE) ? 1 : 2;
+    return calcularTotalBytes(attrs.width, 1, bytesPerComponent);
+}
+
+bool LectorPPMPorFilas::leerFila(std::span<uint8_t> destino) {
+    const FaseMedida fase{"read"};
+    return file.read(std::bit_cast<char*>(destino.data()), static_cast<std::streamsize>(destino.size())).good();
+}
+
+bool LectorPPMPorFilas::saltarFilas(std::size_t filas) {
+    return file.seekg(static_cast<std::streamoff>(filas * bytesPorFila()), std::ios::cur).good();
+}
+
 bool leerImagenCPPM(const std::string& filePath, PPMImage& image) {
   try {
     std::ifstream file(filePath, std::ios::binary);
@@ -2,9 +2,21 @@
 #ifndef BINARIO_HPP
 #define BINARIO_HPP
 
+#include "planos.hpp"
+#include "reserva.hpp"
+
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <span>
+
+// Los componentes de hasta 8 bits (maxValue <= 255) se guardan como uint8_t y los de
+// 16 bits como uint16_t en el orden nativo: se pasan del orden del archivo (byte alto
+// primero) una sola vez al leer y al escribir, y las operaciones trabajan con palabras.
+// Cada imagen usa solo el almacenamiento de su profundidad; el otro queda vacío.
 
 // Structures for AOS (Array of Structures) representation
 struct PPMAttributes {
@@ -17,7 +29,10 @@ struct PPMImage {
   int width = 0;
   int height = 0;
   int maxValue = 0;
-  std::vector<uint8_t> pixelData;
+  // Componentes intercalados RGB; salen de la reserva de búferes (reserva.hpp), que los
+  // recicla entre imágenes y respalda los grandes con páginas grandes
+  VectorReserva<uint8_t> pixelData;
+  VectorReserva<uint16_t> pixelData16;
 
   PPMImage() = default;
 
@@ -30,9 +45,9 @@ struct PPMImageSoA {
   int width = 0;
   int height = 0;
   int maxValue = 0;
-  std::vector<uint8_t> redChannel;
-  std::vector<uint8_t> greenChannel;
-  std::vector<uint8_t> blueChannel;
+  // Canales R, G y B en una sola reserva alineada, con las filas rellenadas (planos.hpp)
+  PlanosAlineados<uint8_t> planos;
+  PlanosAlineados<uint16_t> planos16;
 
   PPMImageSoA() = default;
 
@@ -48,6 +63,34 @@ bool escribirImagenPPM(const std::string& filePath, const PPMImage& image);
 bool leerImagenPPMSoA(const std::string& filePath, PPMImageSoA& image);
 bool escribirImagenPPMSoA(const std::string& filePath, const PPMImageSoA& image);
 
+// Escritura por franjas de filas: el productor rellena directamente el búfer de salida
+// con los bytes de las filas [rowBegin, rowEnd) tal y como deben quedar en el archivo,
+// de modo que la operación no necesita una imagen de salida completa en memoria.
+using ProductorFilas = std::function<void(std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd)>;
+bool escribirImagenPPMPorFilas(const std::string& filePath, const PPMAttributes& attrs,
+                               const ProductorFilas& productor);
+
+// Escribe una imagen SOA intercalando los canales franja a franja, sin copia AOS completa;
+// los componentes de 16 bits se escriben con el byte alto primero, como indica el formato.
+bool escribirImagenPPMSoAPorFilas(const std::string& filePath, const PPMImageSoA& image);
+
+// Lectura por filas: abre un P6 y entrega las filas del cuerpo de una en una, tal y como
+// están en el archivo (16 bits con el byte alto primero), sin cargar la imagen completa.
+class LectorPPMPorFilas {
+  public:
+  bool abrir(const std::string& filePath);
+  [[nodiscard]] const PPMAttributes& atributos() const;
+  [[nodiscard]] std::size_t bytesPorFila() const;
+  // Lee la siguiente fila; destino debe medir bytesPorFila()
+  bool leerFila(std::span<uint8_t> destino);
+  // Avanza `filas` filas sin leerlas: el cuerpo P6 tiene un paso fijo, así que basta un seek
+  bool saltarFilas(std::size_t filas);
+
+  private:
+  std::ifstream file;
+  PPMAttributes attrs{};
+};
+
 // Funciones específicas para tests CPPM
 bool leerImagenCPPM(const std::string& filePath, PPMImage& image);
 
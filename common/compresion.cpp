@@ -0,0 +1,111 @@
+// File: common/compresion.cpp
+#include "compresion.hpp"
+
+#include "estadisticas.hpp"
+#include "imagen.hpp"
+#include "nucleos.hpp"
+#include "reserva.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  constexpr std::size_t MAX_COLORES_1BYTE = 256;
+  constexpr std::size_t MAX_COLORES_2BYTES = 65536;
+  constexpr std::size_t BYTES_INDICE_MAXIMO = 4;
+
+  // Colores únicos ordenados y el índice de cada píxel en esa tabla
+  struct TablaColores {
+    std::pmr::vector<ClaveColor> colores;
+    std::pmr::vector<uint32_t> indices;
+  };
+
+  template <typename Vista>
+  TablaColores generarTablaColores(const Vista& vista, std::pmr::memory_resource* memoria) {
+    TablaColores tabla{.colores = std::pmr::vector<ClaveColor>{memoria}, .indices = std::pmr::vector<uint32_t>{memoria}};
+    tabla.indices.reserve(vista.pixeles());
+    std::pmr::unordered_map<ClaveColor, uint32_t> posiciones{memoria};
+    paraCadaPixel(vista, [&](const Vista& fila, std::size_t x) {
+      const ClaveColor color = claveColor(fila, x);
+      if (posiciones.try_emplace(color, static_cast<uint32_t>(tabla.colores.size())).second) {
+        tabla.colores.push_back(color);
+      }
+    });
+    // Las claves ordenan por (rojo, verde, azul); se renumeran los colores en ese orden
+    std::ranges::sort(tabla.colores);
+    for (std::size_t i = 0; i < tabla.colores.size(); ++i) {
+      posiciones[tabla.colores[i]] = static_cast<uint32_t>(i);
+    }
+    paraCadaPixel(vista,
+                  [&](const Vista& fila, std::size_t x) { tabla.indices.push_back(posiciones[claveColor(fila, x)]); });
+    return tabla;
+  }
+
+  std::size_t bytesPorIndice(std::size_t colores) {
+    if (colores <= MAX_COLORES_1BYTE) {
+      return 1;
+    }
+    return (colores <= MAX_COLORES_2BYTES) ? 2 : BYTES_INDICE_MAXIMO;
+  }
+
+  void escribirBytes(std::ofstream& output, std::span<uint8_t const> datos) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    output.write(reinterpret_cast<const char*>(datos.data()), static_cast<std::streamsize>(datos.size()));
+  }
+
+  template <typename T>
+  void escribirTabla(std::ofstream& output, const PPMAttributes& attrs, const TablaColores& tabla) {
+    output << "C6 " << attrs.width << " " << attrs.height << " " << attrs.maxValue << " " << tabla.colores.size()
+           << "\n";
+    // La tabla se escribe en el orden nativo: con 16 bits, el byte bajo primero
+    std::pmr::vector<T> colores(tabla.colores.size() * CANALES_RGB, tabla.colores.get_allocator());
+    for (std::size_t i = 0; i < tabla.colores.size(); ++i) {
+      for (std::size_t canal = 0; canal < CANALES_RGB; ++canal) {
+        colores[(i * CANALES_RGB) + canal] = static_cast<T>(canalDeClave(tabla.colores[i], canal));
+      }
+    }
+    escribirBytes(output, bytesDe(std::span<T>{colores}));
+
+    // Se estrechan todos los índices en un búfer y se escriben de una vez
+    const std::size_t bytes = bytesPorIndice(tabla.colores.size());
+    std::pmr::vector<uint8_t> indices(tabla.indices.size() * bytes, tabla.indices.get_allocator());
+    estrecharIndices(tabla.indices, indices, bytes);
+    escribirBytes(output, indices);
+  }
+
+  template <typename Imagen>
+  bool comprimir(const std::string& filePath, const Imagen& image) {
+    return segunProfundidad(image.maxValue, [&]<typename T>(T) {
+      // La tabla, los índices y el búfer de salida van en la arena de la llamada
+      ArenaTemporal arena;
+      const TablaColores tabla = [&] {
+        const FaseMedida fase{"kernel"};
+        return generarTablaColores(vistaImagen<T>(image), &arena);
+      }();
+      std::ofstream output(filePath, std::ios::binary);
+      if (!output) {
+        std::cerr << "Error al abrir el archivo de salida.\n";
+        return false;
+      }
+      const FaseMedida fase{"write"};
+      escribirTabla<T>(output, {.width = image.width, .height = image.height, .maxValue = image.maxValue}, tabla);
+      return static_cast<bool>(output);
+    });
+  }
+}  // namespace
+
+bool escribirImagenComprimida(const std::string& filePath, const PPMImage& image) {
+  return comprimir(filePath, image);
+}
+
+bool escribirImagenComprimida(const std::string& filePath, const PPMImageSoA& image) {
+  return comprimir(filePath, image);
+}
@@ -0,0 +1,22 @@
+// File: common/compresion.hpp
+#ifndef COMPRESION_HPP
+#define COMPRESION_HPP
+
+#include "binario.hpp"
+
+#include <string>
+
+/**
+ * @brief Operación compress, escrita una sola vez sobre VistaImagen para AOS y SOA.
+ *
+ * Escribe la imagen en formato CPPM: cabecera "C6 width height maxValue colores", la
+ * tabla de colores únicos ordenada por (rojo, verde, azul), con 1 o 2 bytes por
+ * componente, y el índice de cada píxel en la tabla con 1, 2 o 4 bytes según el número
+ * de colores. Los valores de más de un byte se escriben con el byte bajo primero.
+ *
+ * @return false si no se puede escribir el archivo (el error se informa por std::cerr).
+ */
+bool escribirImagenComprimida(const std::string& filePath, const PPMImage& image);
+bool escribirImagenComprimida(const std::string& filePath, const PPMImageSoA& image);
+
+#endif // COMPRESION_HPP
@@ -0,0 +1,132 @@
+// File: common/contadores.cpp
+#include "contadores.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  constexpr int SIN_DESCRIPTOR = -1;
+  constexpr std::array<const char*, NUM_CONTADORES> NOMBRES = {"cycles", "instructions", "l1d_misses",
+                                                              "llc_misses", "branch_misses"};
+
+#ifdef __linux__
+  constexpr unsigned int DESPLAZAMIENTO_OPERACION = 8;
+  constexpr unsigned int DESPLAZAMIENTO_RESULTADO = 16;
+
+  struct EventoPerf {
+    uint32_t tipo;
+    uint64_t configuracion;
+  };
+
+  // Evento de perf de cada Contador, en el mismo orden
+  constexpr std::array<EventoPerf, NUM_CONTADORES> EVENTOS = {{
+      {.tipo = PERF_TYPE_HARDWARE, .configuracion = PERF_COUNT_HW_CPU_CYCLES},
+      {.tipo = PERF_TYPE_HARDWARE, .configuracion = PERF_COUNT_HW_INSTRUCTIONS},
+      {.tipo = PERF_TYPE_HW_CACHE,
+       .configuracion = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << DESPLAZAMIENTO_OPERACION) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << DESPLAZAMIENTO_RESULTADO)},
+      {.tipo = PERF_TYPE_HARDWARE, .configuracion = PERF_COUNT_HW_CACHE_MISSES},
+      {.tipo = PERF_TYPE_HARDWARE, .configuracion = PERF_COUNT_HW_BRANCH_MISSES},
+  }};
+
+  // Formato de read() con PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+  struct LecturaPerf {
+    uint64_t valor;
+    uint64_t habilitado;
+    uint64_t activo;
+  };
+
+  int abrirEvento(const EventoPerf& evento) {
+    perf_event_attr atributos{};
+    atributos.size = sizeof(atributos);
+    atributos.type = evento.tipo;
+    atributos.config = evento.configuracion;
+    atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    atributos.inherit = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    // pid 0 y cpu -1: este proceso (y los hilos que cree) en cualquier núcleo
+    return static_cast<int>(syscall(SYS_perf_event_open, &atributos, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+  }
+
+  uint64_t leerEvento(int descriptor) {
+    LecturaPerf lectura{};
+    if (read(descriptor, &lectura, sizeof(lectura)) != static_cast<ssize_t>(sizeof(lectura)) || lectura.activo == 0) {
+      return 0;
+    }
+    if (lectura.activo == lectura.habilitado) {
+      return lectura.valor;
+    }
+    // Multiplexado: se extrapola a todo el tiempo en que el contador estuvo habilitado
+    return static_cast<uint64_t>(static_cast<double>(lectura.valor) * static_cast<double>(lectura.habilitado) /
+                                 static_cast<double>(lectura.activo));
+  }
+#endif
+}  // namespace
+
+const char* nombreContador(Contador contador) {
+  return NOMBRES.at(static_cast<std::size_t>(contador));
+}
+
+ContadoresHardware::ContadoresHardware() {
+  descriptores.fill(SIN_DESCRIPTOR);
+}
+
+ContadoresHardware::~ContadoresHardware() {
+#ifdef __linux__
+  for (const int descriptor : descriptores) {
+    if (descriptor != SIN_DESCRIPTOR) {
+      close(descriptor);
+    }
+  }
+#endif
+}
+
+bool ContadoresHardware::abrir() {
+#ifdef __linux__
+  for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+    descriptores.at(i) = abrirEvento(EVENTOS.at(i));
+    if (descriptores.at(i) == SIN_DESCRIPTOR && mensajeError.empty()) {
+      mensajeError = std::string("perf_event_open: ") + std::strerror(errno);  // NOLINT(concurrency-mt-unsafe)
+    }
+  }
+#else
+  mensajeError = "hardware counters are only supported on Linux";
+#endif
+  return algunoDisponible();
+}
+
+bool ContadoresHardware::disponible(Contador contador) const {
+  return descriptores.at(static_cast<std::size_t>(contador)) != SIN_DESCRIPTOR;
+}
+
+bool ContadoresHardware::algunoDisponible() const {
+  return std::ranges::any_of(descriptores, [](int descriptor) { return descriptor != SIN_DESCRIPTOR; });
+}
+
+const std::string& ContadoresHardware::error() const {
+  return mensajeError;
+}
+
+LecturaContadores ContadoresHardware::leer() const {
+  LecturaContadores valores{};
+#ifdef __linux__
+  for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+    if (descriptores.at(i) != SIN_DESCRIPTOR) {
+      valores.at(i) = leerEvento(descriptores.at(i));
+    }
+  }
+#endif
+  return valores;
+}
@@ -0,0 +1,69 @@
+// File: common/contadores.hpp
+#ifndef CONTADORES_HPP
+#define CONTADORES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Contadores hardware que se miden en cada fase.
+ *
+ * fallosL1 son los fallos de lectura en la caché L1 de datos y fallosLLC los de la caché
+ * de último nivel, según los define el kernel para el procesador.
+ */
+enum class Contador : std::size_t { ciclos, instrucciones, fallosL1, fallosLLC, fallosSalto };
+
+inline constexpr std::size_t NUM_CONTADORES = 5;
+
+/**
+ * @brief Valor de cada contador, indexado por Contador.
+ */
+using LecturaContadores = std::array<uint64_t, NUM_CONTADORES>;
+
+/**
+ * @brief Nombre del contador en el informe ("cycles", "instructions", "l1d_misses",
+ * "llc_misses" o "branch_misses").
+ */
+[[nodiscard]] const char* nombreContador(Contador contador);
+
+/**
+ * @brief Contadores hardware del proceso, leídos con perf_event_open (solo Linux).
+ *
+ * Cuentan solo en modo usuario e incluyen los hilos creados después de abrirlos, de modo
+ * que deben abrirse antes de que arranque el grupo de hilos. Cada contador se abre por
+ * separado: si el procesador, el kernel (perf_event_paranoid) o la máquina virtual no
+ * ofrecen alguno, ese queda no disponible y los demás siguen funcionando. Cuando el
+ * kernel los multiplexa, los valores se extrapolan al tiempo total habilitado.
+ */
+class ContadoresHardware {
+  public:
+  ContadoresHardware();
+  ContadoresHardware(const ContadoresHardware&) = delete;
+  ContadoresHardware(ContadoresHardware&&) = delete;
+  ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+  ContadoresHardware& operator=(ContadoresHardware&&) = delete;
+  ~ContadoresHardware();
+
+  /**
+   * @brief Abre todos los contadores posibles.
+   * @return false si no se pudo abrir ninguno; error() explica el motivo.
+   */
+  bool abrir();
+
+  [[nodiscard]] bool disponible(Contador contador) const;
+  [[nodiscard]] bool algunoDisponible() const;
+  [[nodiscard]] const std::string& error() const;
+
+  /**
+   * @brief Valor acumulado de cada contador (0 en los no disponibles).
+   */
+  [[nodiscard]] LecturaContadores leer() const;
+
+  private:
+  std::array<int, NUM_CONTADORES> descriptores{};
+  std::string mensajeError;
+};
+
+#endif // CONTADORES_HPP
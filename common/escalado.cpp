@@ -0,0 +1,244 @@
+// File: common/escalado.cpp
+#include "escalado.hpp"
+#include "isa.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+  // Razones de reducción con núcleos de área especializados
+  constexpr std::array<std::size_t, 3> FACTORES_ENTEROS = {2, 4, 8};
+
+  // Índice original más cercano al centro de cada píxel de salida
+  TablaEje tablaVecino(std::size_t original, std::size_t nuevo) {
+    TablaEje tabla{.bajo = std::vector<std::size_t>(nuevo), .alto = {}, .peso = {}};
+    for (std::size_t i = 0; i < nuevo; ++i) {
+      tabla.bajo[i] = std::min(original - 1, (((2 * i) + 1) * original) / (2 * nuevo));
+    }
+    return tabla;
+  }
+
+  // Rango [bajo, alto) de índices originales que cubre cada píxel de salida (al menos uno)
+  TablaEje tablaArea(std::size_t original, std::size_t nuevo) {
+    TablaEje tabla{.bajo = std::vector<std::size_t>(nuevo), .alto = std::vector<std::size_t>(nuevo), .peso = {}};
+    for (std::size_t i = 0; i < nuevo; ++i) {
+      const std::size_t inicio = std::min(original - 1, (i * original) / nuevo);
+      tabla.bajo[i] = inicio;
+      tabla.alto[i] = std::clamp(((i + 1) * original) / nuevo, inicio + 1, original);
+    }
+    return tabla;
+  }
+
+  std::size_t calcularFactorEntero(PlanoOrigen const & origen, PlanoDestino const & destino) {
+    for (const std::size_t factor : FACTORES_ENTEROS) {
+      if (origen.width == destino.width * factor && origen.height == destino.height * factor) {
+        return factor;
+      }
+    }
+    return 0;
+  }
+
+  // Vecino más cercano: copia directa de los bytes de cada píxel
+  void escalarFranjaVecino(PlanEscalado const & plan, PlanoOrigen const & origen, PlanoDestino const & destino,
+                           RangoFilas filas) {
+    const std::size_t bytesPixel = origen.canales * origen.bytesPorComponente;
+    const std::size_t bytesFila = destino.width * bytesPixel;
+    for (std::size_t y = filas.inicio; y < filas.fin; ++y) {
+      const std::span<uint8_t const> fila = filaOrigen(origen, plan.y.bajo[y]);
+      const std::span<uint8_t> salida = filaDestino(destino, y, bytesFila);
+      for (std::size_t x = 0; x < destino.width; ++x) {
+        std::ranges::copy(fila.subspan(plan.x.bajo[x] * bytesPixel, bytesPixel),
+                          salida.subspan(x * bytesPixel).begin());
+      }
+    }
+  }
+
+  // Sumas por columna de las filas originales que cubre una fila de salida
+  template <typename Acumulador>
+  struct ColumnasSumadas {
+    std::span<Acumulador const> valores;
+    std::size_t filas;
+    std::size_t canales;
+  };
+
+  template <typename T, typename Acumulador>
+  [[gnu::always_inline]] inline void sumarFilasCuerpo(PlanoOrigen const & origen, std::size_t inicio,
+                                                      std::size_t fin, std::span<Acumulador> columnas) {
+    std::ranges::fill(columnas, Acumulador{0});
+    for (std::size_t fila = inicio; fila < fin; ++fila) {
+      const std::span<uint8_t const> datos = filaOrigen(origen, fila);
+      for (std::size_t i = 0; i < columnas.size(); ++i) {
+        columnas[i] += leerComponente<T>(datos, i);
+      }
+    }
+  }
+
+  // Variantes por nivel de instrucciones (isa.hpp) de la suma de filas
+  template <typename Acumulador>
+  using NucleoSumarFilas = void (*)(PlanoOrigen const &, std::size_t, std::size_t, std::span<Acumulador>);
+
+  template <typename T, typename Acumulador>
+  void sumarFilasBase(PlanoOrigen const & origen, std::size_t inicio, std::size_t fin,
+                      std::span<Acumulador> columnas) {
+    sumarFilasCuerpo<T, Acumulador>(origen, inicio, fin, columnas);
+  }
+
+  template <typename T, typename Acumulador>
+  IMTOOL_DESTINO_AVX2 void sumarFilasAvx2(PlanoOrigen const & origen, std::size_t inicio, std::size_t fin,
+                                          std::span<Acumulador> columnas) {
+    sumarFilasCuerpo<T, Acumulador>(origen, inicio, fin, columnas);
+  }
+
+  template <typename T, typename Acumulador>
+  IMTOOL_DESTINO_AVX512 void sumarFilasAvx512(PlanoOrigen const & origen, std::size_t inicio, std::size_t fin,
+                                              std::span<Acumulador> columnas) {
+    sumarFilasCuerpo<T, Acumulador>(origen, inicio, fin, columnas);
+  }
+
+  template <typename T, typename Acumulador>
+  constexpr VariantesISA<NucleoSumarFilas<Acumulador>> SUMAR_FILAS{.base = &sumarFilasBase<T, Acumulador>,
+                                                                   .avx2 = &sumarFilasAvx2<T, Acumulador>,
+                                                                   .avx512 = &sumarFilasAvx512<T, Acumulador>};
+
+  // Media redondeada de cada caja horizontal. Con K > 0 la caja es de K x K y su
+  // tamaño se conoce al compilar, de modo que la división se reduce a un desplazamiento.
+  template <typename T, std::size_t K, typename Acumulador>
+  void promediarCajas(ColumnasSumadas<Acumulador> const & columnas, TablaEje const & tablaX,
+                      std::span<uint8_t> salida) {
+    const std::size_t canales = columnas.canales;
+    for (std::size_t x = 0; x < tablaX.bajo.size(); ++x) {
+      const std::size_t inicio = (K > 0) ? x * K : tablaX.bajo[x];
+      const std::size_t ancho = (K > 0) ? K : tablaX.alto[x] - inicio;
+      const auto cuenta = static_cast<Acumulador>((K > 0) ? K * K : ancho * columnas.filas);
+      for (std::size_t canal = 0; canal < canales; ++canal) {
+        Acumulador suma = 0;
+        for (std::size_t k = 0; k < ancho; ++k) {
+          suma += columnas.valores[((inicio + k) * canales) + canal];
+        }
+        escribirComponente<T>(salida, (x * canales) + canal, static_cast<uint32_t>((suma + (cuenta / 2)) / cuenta));
+      }
+    }
+  }
+
+  // Media por áreas: K > 0 para los factores enteros; 0 para cajas de tamaño variable,
+  // que acumulan en 64 bits porque pueden cubrir muchos píxeles
+  template <typename T, std::size_t K>
+  void escalarFranjaArea(PlanEscalado const & plan, PlanoOrigen const & origen, PlanoDestino const & destino,
+                         RangoFilas filas) {
+    using Acumulador = std::conditional_t<K == 0, uint64_t, uint32_t>;
+    const std::size_t bytesFila = destino.width * origen.canales * sizeof(T);
+    std::vector<Acumulador> columnas(origen.width * origen.canales);
+    const NucleoSumarFilas<Acumulador> sumarFilas = elegirVariante(SUMAR_FILAS<T, Acumulador>);
+    for (std::size_t y = filas.inicio; y < filas.fin; ++y) {
+      const std::size_t inicio = (K > 0) ? y * K : plan.y.bajo[y];
+      const std::size_t fin = (K > 0) ? inicio + K : plan.y.alto[y];
+      sumarFilas(origen, inicio, fin, columnas);
+      promediarCajas<T, K, Acumulador>({.valores = columnas, .filas = fin - inicio, .canales = origen.canales},
+                                       plan.x, filaDestino(destino, y, bytesFila));
+    }
+  }
+
+  template <typename T>
+  void elegirNucleoArea(PlanEscalado const & plan, PlanoOrigen const & origen, PlanoDestino const & destino,
+                        RangoFilas filas) {
+    constexpr std::size_t FACTOR_2 = 2;
+    constexpr std::size_t FACTOR_4 = 4;
+    constexpr std::size_t FACTOR_8 = 8;
+    switch (plan.factorEntero) {
+      case FACTOR_2: escalarFranjaArea<T, FACTOR_2>(plan, origen, destino, filas); break;
+      case FACTOR_4: escalarFranjaArea<T, FACTOR_4>(plan, origen, destino, filas); break;
+      case FACTOR_8: escalarFranjaArea<T, FACTOR_8>(plan, origen, destino, filas); break;
+      default: escalarFranjaArea<T, 0>(plan, origen, destino, filas); break;
+    }
+  }
+}  // namespace
+
+FiltroEscalado leerFiltroEscalado(const std::string& nombre) {
+  if (nombre == "nearest") {
+    return FiltroEscalado::vecino;
+  }
+  if (nombre == "bilinear") {
+    return FiltroEscalado::bilineal;
+  }
+  if (nombre == "area") {
+    return FiltroEscalado::area;
+  }
+  throw std::invalid_argument("Invalid resize filter: " + nombre);
+}
+
+PlanEscalado crearPlanEscalado(FiltroEscalado filtro, const PlanoOrigen& origen, const PlanoDestino& destino) {
+  PlanEscalado plan{.filtro = filtro, .x = {}, .y = {}, .factorEntero = 0};
+  switch (filtro) {
+    case FiltroEscalado::vecino:
+      plan.x = tablaVecino(origen.width, destino.width);
+      plan.y = tablaVecino(origen.height, destino.height);
+      break;
+    case FiltroEscalado::area:
+      plan.x = tablaArea(origen.width, destino.width);
+      plan.y = tablaArea(origen.height, destino.height);
+      plan.factorEntero = calcularFactorEntero(origen, destino);
+      break;
+    case FiltroEscalado::bilineal:
+      plan.x = calcularTablaEje(static_cast<int>(origen.width), static_cast<int>(destino.width),
+                                origen.bytesPorComponente);
+      plan.y = calcularTablaEje(static_cast<int>(origen.height), static_cast<int>(destino.height),
+                                origen.bytesPorComponente);
+      break;
+  }
+  return plan;
+}
+
+void escalarPlano(const PlanEscalado& plan, const PlanoOrigen& origen, const PlanoDestino& destino) {
+  escalarFilas(plan, origen, destino, {.inicio = 0, .fin = destino.height});
+}
+
+void escalarFilas(const PlanEscalado& plan, const PlanoOrigen& origen, const PlanoDestino& destino,
+                  RangoFilas filas) {
+  if (plan.filtro == FiltroEscalado::bilineal) {
+    escalarPlanoBilineal(origen, destino, {.x = plan.x, .y = plan.y}, filas);
+    return;
+  }
+  parallelForRows(filas.fin - filas.inicio, destino.width * origen.canales, [&](std::size_t primera, std::size_t ultima) {
+    const RangoFilas franja{.inicio = filas.inicio + primera, .fin = filas.inicio + ultima};
+    if (plan.filtro == FiltroEscalado::vecino) {
+      escalarFranjaVecino(plan, origen, destino, franja);
+    } else if (origen.bytesPorComponente == 1) {
+      elegirNucleoArea<uint8_t>(plan, origen, destino, franja);
+    } else {
+      elegirNucleoArea<uint16_t>(plan, origen, destino, franja);
+    }
+  });
+}
+
+RangoFilas filasNecesarias(const PlanEscalado& plan, std::size_t filaSalida) {
+  const std::size_t inicio = plan.y.bajo[filaSalida];
+  switch (plan.filtro) {
+    case FiltroEscalado::vecino:
+      return {.inicio = inicio, .fin = inicio + 1};
+    case FiltroEscalado::area:
+      return {.inicio = inicio, .fin = plan.y.alto[filaSalida]};
+    case FiltroEscalado::bilineal:
+      break;
+  }
+  return {.inicio = inicio, .fin = plan.y.alto[filaSalida] + 1};
+}
+
+int tamanoNivelPiramide(int tamano) {
+  return std::max(1, tamano / 2);
+}
+
+std::string rutaNivelPiramide(const std::string& rutaBase, int nivel) {
+  const std::filesystem::path ruta{rutaBase};
+  std::filesystem::path nivelRuta = ruta.parent_path();
+  nivelRuta /= ruta.stem().string() + "-" + std::to_string(nivel) + ruta.extension().string();
+  return nivelRuta.string();
+}
@@ -0,0 +1,88 @@
+// File: common/escalado.hpp
+#ifndef ESCALADO_HPP
+#define ESCALADO_HPP
+
+#include "bilineal.hpp"
+#include "plano.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Filtro usado para calcular cada píxel de la imagen escalada.
+ *
+ * - vecino: copia el píxel original más cercano (el más rápido, para vistas previas).
+ * - bilineal: interpola los cuatro píxeles vecinos (por defecto).
+ * - area: media de todos los píxeles originales que cubre el píxel de salida; evita el
+ *   aliasing en reducciones grandes.
+ */
+enum class FiltroEscalado { vecino, bilineal, area };
+
+/**
+ * @brief Traduce el nombre de un filtro ("nearest", "bilinear" o "area").
+ * @throws std::invalid_argument si el nombre no corresponde a ningún filtro.
+ */
+FiltroEscalado leerFiltroEscalado(const std::string& nombre);
+
+/**
+ * @brief Parámetros de una operación de escalado.
+ */
+struct OpcionesEscalado {
+  int width;
+  int height;
+  FiltroEscalado filtro;
+};
+
+/**
+ * @brief Tablas de ambos ejes de un escalado, calculadas una sola vez por imagen y
+ * compartidas por todos sus planos (los tres canales en SOA).
+ *
+ * El significado de cada TablaEje depende del filtro: en bilineal son los dos vecinos
+ * y su peso; en vecino, `bajo` es el índice original; en area, [bajo, alto) es el
+ * rango de índices originales que se promedian. factorEntero es la razón de reducción
+ * cuando es 2, 4 u 8 en ambos ejes (0 en otro caso) y selecciona los núcleos de área
+ * especializados.
+ */
+struct PlanEscalado {
+  FiltroEscalado filtro;
+  TablaEje x;
+  TablaEje y;
+  std::size_t factorEntero;
+};
+
+/**
+ * @brief Calcula el plan para escalar planos con la forma de origen a la de destino.
+ */
+PlanEscalado crearPlanEscalado(FiltroEscalado filtro, const PlanoOrigen& origen, const PlanoDestino& destino);
+
+/**
+ * @brief Escala un plano según un plan calculado con crearPlanEscalado.
+ *
+ * Las filas de salida se reparten en franjas entre los hilos del grupo compartido.
+ */
+void escalarPlano(const PlanEscalado& plan, const PlanoOrigen& origen, const PlanoDestino& destino);
+
+/**
+ * @brief Escala solo las filas de salida `filas`; el origen debe contener todas las
+ * filas que indica filasNecesarias para ellas.
+ */
+void escalarFilas(const PlanEscalado& plan, const PlanoOrigen& origen, const PlanoDestino& destino,
+                  RangoFilas filas);
+
+/**
+ * @brief Filas de origen [inicio, fin) que lee el filtro para calcular la fila de salida
+ * filaSalida. Ambos extremos son crecientes con filaSalida.
+ */
+RangoFilas filasNecesarias(const PlanEscalado& plan, std::size_t filaSalida);
+
+/**
+ * @brief Tamaño de un eje en el siguiente nivel de una pirámide (la mitad, mínimo 1).
+ */
+int tamanoNivelPiramide(int tamano);
+
+/**
+ * @brief Ruta del nivel `nivel` de una pirámide: "dir/foto.ppm" -> "dir/foto-<nivel>.ppm".
+ */
+std::string rutaNivelPiramide(const std::string& rutaBase, int nivel);
+
+#endif // ESCALADO_HPP
@@ -0,0 +1,270 @@
+// File: common/estadisticas.cpp
+#include "estadisticas.hpp"
+
+#include "contadores.hpp"
+#include "isa.hpp"
+#include "memoria.hpp"
+#include "reserva.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+  using Reloj = std::chrono::steady_clock;
+
+  constexpr char SEPARADOR_FASES = '/';
+  constexpr int DECIMALES_MS = 3;
+  constexpr unsigned char PRIMER_IMPRIMIBLE = 0x20;
+  constexpr double NS_POR_MS = 1e6;
+
+  // Memoria reservada durante una fase y máximo de bytes vivos mientras estuvo abierta
+  struct MemoriaFase {
+    std::uint64_t bytes;
+    std::uint64_t asignaciones;
+    std::int64_t pico;
+  };
+
+  struct RegistroFase {
+    std::string nombre;
+    std::uint64_t llamadas;
+    std::chrono::nanoseconds total;
+    LecturaContadores contadores;
+    MemoriaFase memoria;
+  };
+
+  // Estado global de la medición: se activa una vez, antes de la operación
+  struct Medicion {
+    bool activa = false;
+    bool conContadores = false;
+    std::string destino;
+    Reloj::time_point inicio;
+    ContadoresHardware contadores;
+    std::mutex mutex;
+    std::vector<RegistroFase> fases;
+  };
+
+  Medicion & medicion() {
+    static Medicion estado;
+    return estado;
+  }
+
+  // Nombre completo de las fases abiertas en este hilo, separadas por '/'
+  thread_local std::string rutaActual;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  void registrarFase(const std::string & nombre, std::chrono::nanoseconds duracion, const LecturaContadores & eventos,
+                     const MemoriaFase & memoria) {
+    Medicion & estado = medicion();
+    const std::lock_guard lock{estado.mutex};
+    auto encontrada = std::ranges::find(estado.fases, nombre, &RegistroFase::nombre);
+    if (encontrada == estado.fases.end()) {
+      estado.fases.push_back({.nombre = nombre, .llamadas = 0, .total = {}, .contadores = {}, .memoria = {}});
+      encontrada = std::prev(estado.fases.end());
+    }
+    ++encontrada->llamadas;
+    encontrada->total += duracion;
+    for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+      encontrada->contadores.at(i) += eventos.at(i);
+    }
+    encontrada->memoria.bytes += memoria.bytes;
+    encontrada->memoria.asignaciones += memoria.asignaciones;
+    encontrada->memoria.pico = std::max(encontrada->memoria.pico, memoria.pico);
+  }
+
+  double milisegundos(std::chrono::nanoseconds duracion) {
+    return static_cast<double>(duracion.count()) / NS_POR_MS;
+  }
+
+  // Cadena JSON con las comillas, barras y caracteres de control escapados
+  void escribirCadena(std::ostream & salida, std::string_view texto) {
+    salida << '"';
+    for (const char caracter : texto) {
+      if (caracter == '"' || caracter == '\\') {
+        salida << '\\' << caracter;
+      } else if (static_cast<unsigned char>(caracter) < PRIMER_IMPRIMIBLE) {
+        salida << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>(caracter) << std::dec << std::setfill(' ');
+      } else {
+        salida << caracter;
+      }
+    }
+    salida << '"';
+  }
+
+  // Contadores de una fase y, si se conocen ciclos e instrucciones, sus instrucciones por ciclo
+  void escribirContadores(std::ostream & salida, const ContadoresHardware & contadores, const LecturaContadores & valores) {
+    for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+      const auto contador = static_cast<Contador>(i);
+      if (contadores.disponible(contador)) {
+        salida << ", \"" << nombreContador(contador) << "\": " << valores.at(i);
+      }
+    }
+    const uint64_t ciclos = valores.at(static_cast<std::size_t>(Contador::ciclos));
+    if (contadores.disponible(Contador::instrucciones) && ciclos > 0) {
+      salida << ", \"ipc\": "
+             << static_cast<double>(valores.at(static_cast<std::size_t>(Contador::instrucciones))) /
+                    static_cast<double>(ciclos);
+    }
+  }
+
+  // Lista de contadores disponibles o, si se pidieron y no hay ninguno, el motivo
+  void escribirDisponibles(std::ostream & salida, const Medicion & estado) {
+    if (!estado.conContadores) {
+      return;
+    }
+    if (!estado.contadores.algunoDisponible()) {
+      salida << ", \"counters_error\": ";
+      escribirCadena(salida, estado.contadores.error());
+      return;
+    }
+    salida << ", \"counters\": [";
+    const char * separador = "";
+    for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+      if (estado.contadores.disponible(static_cast<Contador>(i))) {
+        salida << separador << '"' << nombreContador(static_cast<Contador>(i)) << '"';
+        separador = ", ";
+      }
+    }
+    salida << "]";
+  }
+
+  // Memoria de todo el proceso: reservas desde la activación y memoria residente máxima
+  void escribirMemoria(std::ostream & salida) {
+    const LecturaMemoria memoria = leerMemoria();
+    salida << ", \"memory\": {\"allocated_bytes\": " << memoria.bytes << ", \"allocations\": " << memoria.asignaciones
+           << ", \"peak_bytes\": " << memoria.pico << ", \"max_rss_kib\": " << residenteMaximoKiB()
+           << ", \"operator_new_hook\": " << (contadorMemoriaGlobal() ? "true" : "false");
+    // Búferes grandes servidos por la reserva (reserva.hpp): reciclados y nuevos
+    const LecturaReserva reserva = leerReserva();
+    salida << ", \"buffer_pool\": {\"reused\": " << reserva.reutilizados << ", \"fresh\": " << reserva.nuevos
+           << ", \"retained_bytes\": " << reserva.bytesRetenidos << "}";
+    // Páginas grandes: si se pueden obtener, modo del núcleo, bytes marcados con madvise,
+    // peticiones que no se pudieron hacer y lo que el núcleo respalda de verdad
+    const std::string modo = reserva.modoPaginasGrandes.empty() ? "unavailable" : reserva.modoPaginasGrandes;
+    salida << ", \"huge_pages\": {\"enabled\": " << (paginasGrandesDisponibles(reserva) ? "true" : "false")
+           << ", \"thp_mode\": \"" << modo << "\", \"advised_bytes\": " << reserva.bytesPaginasGrandes
+           << ", \"advise_failures\": " << reserva.rechazosPaginasGrandes
+           << ", \"anon_huge_kib\": " << paginasGrandesKiB() << "}}";
+  }
+
+  void escribirInforme(std::ostream & salida, const ContextoEstadisticas & contexto, Medicion & estado) {
+    const auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - estado.inicio);
+    salida << std::fixed << std::setprecision(DECIMALES_MS) << "{\"tool\": ";
+    escribirCadena(salida, contexto.herramienta);
+    salida << ", \"operation\": ";
+    escribirCadena(salida, contexto.operacion);
+    salida << ", \"input\": ";
+    escribirCadena(salida, contexto.entrada);
+    salida << ", \"output\": ";
+    escribirCadena(salida, contexto.salida);
+    salida << ", \"threads\": " << threadCount() << ", \"isa\": \"" << nombreNivelISA(nivelISA()) << "\"";
+    salida << ", \"total_ms\": " << milisegundos(total);
+    escribirMemoria(salida);
+    escribirDisponibles(salida, estado);
+    salida << ", \"phases\": [";
+
+    const std::lock_guard lock{estado.mutex};
+    for (std::size_t i = 0; i < estado.fases.size(); ++i) {
+      const RegistroFase & fase = estado.fases[i];
+      salida << ((i == 0) ? "\n  " : ",\n  ") << "{\"name\": ";
+      escribirCadena(salida, fase.nombre);
+      salida << ", \"calls\": " << fase.llamadas << ", \"total_ms\": " << milisegundos(fase.total)
+             << ", \"allocated_bytes\": " << fase.memoria.bytes << ", \"allocations\": " << fase.memoria.asignaciones
+             << ", \"peak_bytes\": " << fase.memoria.pico;
+      if (estado.conContadores) {
+        escribirContadores(salida, estado.contadores, fase.contadores);
+      }
+      salida << "}";
+    }
+    salida << "]}\n";
+  }
+}  // namespace
+
+void activarEstadisticas(const std::string & destino) {
+  Medicion & estado = medicion();
+  estado.destino = destino;
+  estado.inicio = Reloj::now();
+  estado.activa = true;
+  activarContadorMemoria();
+}
+
+bool activarContadoresHardware() {
+  Medicion & estado = medicion();
+  estado.conContadores = true;
+  if (!estado.contadores.abrir()) {
+    std::cerr << "Aviso: contadores hardware no disponibles (" << estado.contadores.error() << ")\n";
+    return false;
+  }
+  return true;
+}
+
+bool estadisticasActivas() {
+  return medicion().activa;
+}
+
+FaseMedida::FaseMedida(std::string_view nombre) : evento(nombre), activa(medicion().activa) {
+  if (!activa) {
+    return;
+  }
+  longitudPadre = rutaActual.size();
+  if (!rutaActual.empty()) {
+    rutaActual += SEPARADOR_FASES;
+  }
+  rutaActual += nombre;
+  if (medicion().conContadores) {
+    inicioContadores = medicion().contadores.leer();
+  }
+  picoAnterior = reiniciarPico();
+  inicioMemoria = leerMemoria();
+  inicio = Reloj::now();
+}
+
+FaseMedida::~FaseMedida() {
+  if (!activa) {
+    return;
+  }
+  const auto duracion = std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - inicio);
+  LecturaContadores eventos{};
+  if (medicion().conContadores) {
+    eventos = medicion().contadores.leer();
+    for (std::size_t i = 0; i < NUM_CONTADORES; ++i) {
+      eventos.at(i) -= inicioContadores.at(i);
+    }
+  }
+  const LecturaMemoria memoria = leerMemoria();
+  restaurarPico(picoAnterior);
+  registrarFase(rutaActual, duracion, eventos,
+                {.bytes = memoria.bytes - inicioMemoria.bytes,
+                 .asignaciones = memoria.asignaciones - inicioMemoria.asignaciones,
+                 .pico = memoria.pico});
+  rutaActual.resize(longitudPadre);
+}
+
+bool escribirEstadisticas(const ContextoEstadisticas & contexto) {
+  Medicion & estado = medicion();
+  if (!estado.activa) {
+    return true;
+  }
+  if (estado.destino.empty()) {
+    escribirInforme(std::cerr, contexto, estado);
+    return true;
+  }
+  std::ofstream archivo(estado.destino);
+  if (!archivo) {
+    std::cerr << "Error al abrir el archivo de estadísticas: " << estado.destino << '\n';
+    return false;
+  }
+  escribirInforme(archivo, contexto, estado);
+  return archivo.good();
+}
@@ -0,0 +1,86 @@
+// File: common/estadisticas.hpp
+#ifndef ESTADISTICAS_HPP
+#define ESTADISTICAS_HPP
+
+#include "contadores.hpp"
+#include "memoria.hpp"
+#include "traza.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Activa la medición de fases (--stats). Hasta que se llama, cada FaseMedida
+ * solo comprueba un indicador y no lee el reloj. Activa también el contador de memoria
+ * (memoria.hpp), así que debe llamarse al principio del programa.
+ *
+ * @param destino Archivo donde escribir el informe JSON; vacío para escribirlo en stderr
+ */
+void activarEstadisticas(const std::string& destino);
+
+/**
+ * @brief Añade a cada fase los contadores hardware de ContadoresHardware (--counters).
+ * Debe llamarse tras activarEstadisticas y antes de crear el grupo de hilos.
+ *
+ * @return false, tras avisar por stderr, si no hay ningún contador disponible; la
+ * medición de tiempos sigue activa y el informe indica el motivo en "counters_error".
+ */
+bool activarContadoresHardware();
+
+/**
+ * @brief Si la medición de fases está activa.
+ */
+[[nodiscard]] bool estadisticasActivas();
+
+/**
+ * @brief Mide el tiempo de una fase desde su construcción hasta su destrucción.
+ *
+ * Las fases pueden anidarse: una fase creada mientras otra está abierta en el mismo hilo
+ * se registra como "externa/interna", y su tiempo está incluido en el de la externa. Las
+ * fases con el mismo nombre completo se acumulan (número de llamadas, tiempo total,
+ * memoria reservada y, si están activos, contadores hardware). El pico de memoria de una
+ * fase es el máximo de bytes vivos mientras estuvo abierta, incluidos los de antes. Con
+ * --trace cada fase es además un evento de la traza, con su nombre sin la ruta.
+ */
+class FaseMedida {
+  public:
+  explicit FaseMedida(std::string_view nombre);
+  FaseMedida(const FaseMedida&) = delete;
+  FaseMedida(FaseMedida&&) = delete;
+  FaseMedida& operator=(const FaseMedida&) = delete;
+  FaseMedida& operator=(FaseMedida&&) = delete;
+  ~FaseMedida();
+
+  private:
+  EventoTraza evento;
+  bool activa;
+  std::size_t longitudPadre = 0;
+  std::chrono::steady_clock::time_point inicio{};
+  LecturaContadores inicioContadores{};
+  LecturaMemoria inicioMemoria{};
+  std::int64_t picoAnterior = 0;
+};
+
+/**
+ * @brief Datos de la ejecución que acompañan a las fases en el informe.
+ */
+struct ContextoEstadisticas {
+  std::string herramienta;
+  std::string operacion;
+  std::string entrada;
+  std::string salida;
+};
+
+/**
+ * @brief Escribe el informe JSON con el tiempo total desde activarEstadisticas y el de
+ * cada fase, en el orden en que se abrieron por primera vez. No hace nada si la medición
+ * no está activa.
+ *
+ * @return false si no se pudo escribir el archivo de destino.
+ */
+bool escribirEstadisticas(const ContextoEstadisticas& contexto);
+
+#endif // ESTADISTICAS_HPP
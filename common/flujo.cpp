@@ -0,0 +1,307 @@
+// File: common/flujo.cpp
+#include "flujo.hpp"
+#include "estadisticas.hpp"
+#include "nucleos.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  constexpr std::size_t BYTES_VENTANA = std::size_t{1} << 22U;  // 4 MiB de filas de origen
+  constexpr int MAX_VALUE_8BIT = 255;
+  constexpr std::size_t COMPONENTES_POR_PIXEL = 3;
+
+  // Tamaño de una imagen repartida en planos
+  struct FormaPlanos {
+    std::size_t width;
+    std::size_t height;
+    DisposicionPlanos disposicion;
+    std::size_t bytesPorComponente;
+
+    [[nodiscard]] std::size_t bytesFilaPlano() const {
+      return width * disposicion.canalesPorPlano * bytesPorComponente;
+    }
+  };
+
+  // Pasa una fila del archivo a las filas correspondientes de los planos: en AOS es una
+  // copia (con los bytes de 16 bits intercambiados) y en SOA se separan los canales
+  void repartirFila(std::span<uint8_t const> fila, std::span<std::span<uint8_t> const> planos,
+                    FormaPlanos const & forma) {
+    if (planos.size() == COMPONENTES_POR_PIXEL) {
+      separarCanales(fila, {planos[0], planos[1], planos[2]}, forma.bytesPorComponente);
+    } else if (forma.bytesPorComponente == 1) {
+      std::memcpy(planos[0].data(), fila.data(), fila.size());
+    } else {
+      copiarIntercambiando16(fila, planos[0]);
+    }
+  }
+
+  // Operación inversa: intercala las filas de los planos en una fila del archivo
+  void intercalarFila(std::span<std::span<uint8_t const> const> planos, std::span<uint8_t> fila,
+                      FormaPlanos const & forma) {
+    if (planos.size() == COMPONENTES_POR_PIXEL) {
+      intercalarCanales({planos[0], planos[1], planos[2]}, fila, forma.bytesPorComponente);
+    } else if (forma.bytesPorComponente == 1) {
+      std::memcpy(fila.data(), planos[0].data(), fila.size());
+    } else {
+      copiarIntercambiando16(planos[0], fila);
+    }
+  }
+
+  // Reducción previa al cargar, por eje: cada píxel intermedio es la media de una
+  // muestra de 2x2 píxeles del centro de su bloque de x por y píxeles originales
+  struct Diezmado {
+    std::size_t x;
+    std::size_t y;
+  };
+
+  // Posiciones del bloque que se muestrean: el par central, o la única si no se reduce
+  std::vector<std::size_t> muestrasBloque(std::size_t factor) {
+    if (factor == 1) {
+      return {0};
+    }
+    return {(factor / 2) - 1, factor / 2};
+  }
+
+  // Mayor potencia de 2 que deja el eje al menos al doble del tamaño final, de modo que
+  // el filtro final siga interpolando entre píxeles ya promediados
+  std::size_t factorDiezmado(std::size_t original, std::size_t nuevo) {
+    std::size_t factor = 1;
+    while (4 * factor * nuevo <= original) {
+      factor *= 2;
+    }
+    return factor;
+  }
+
+  // Solo el bilineal se reduce al cargar: el vecino ya lee únicamente sus filas y el de
+  // área debe promediar todos los píxeles originales
+  Diezmado elegirDiezmado(FiltroEscalado filtro, FormaPlanos const & origen, FormaPlanos const & destino) {
+    if (filtro != FiltroEscalado::bilineal) {
+      return {.x = 1, .y = 1};
+    }
+    return {.x = factorDiezmado(origen.width, destino.width), .y = factorDiezmado(origen.height, destino.height)};
+  }
+
+  FormaPlanos formaDiezmada(FormaPlanos forma, Diezmado diezmado) {
+    forma.width /= diezmado.x;
+    forma.height /= diezmado.y;
+    return forma;
+  }
+
+  // Ventana circular con las últimas `capacidad` filas intermedias cargadas, repartidas
+  // en planos. Las filas del archivo que no se necesitan se saltan sin leerlas.
+  class VentanaFilas {
+    public:
+      VentanaFilas(FormaPlanos archivo, Diezmado diezmado, std::size_t capacidad)
+        : archivo(archivo), forma(formaDiezmada(archivo, diezmado)), diezmado(diezmado),
+          muestrasX(muestrasBloque(diezmado.x)), muestrasY(muestrasBloque(diezmado.y)), capacidad(capacidad),
+          planos(archivo.disposicion.planos, std::vector<uint8_t>(capacidad * forma.bytesFilaPlano())),
+          muestras(muestrasY.size() * planos.size(), std::vector<uint8_t>(archivo.bytesFilaPlano())),
+          filaArchivo(archivo.bytesFilaPlano() * archivo.disposicion.planos) {}
+
+      // Carga las filas [filas.inicio, filas.fin); las anteriores aún no cargadas se saltan
+      void cargar(RangoFilas filas, LectorPPMPorFilas & lector) {
+        cargadas = std::max(cargadas, filas.inicio);
+        for (; cargadas < filas.fin; ++cargadas) {
+          cargarFila(cargadas, lector);
+        }
+      }
+
+      [[nodiscard]] PlanoOrigen plano(std::size_t indice) const {
+        return PlanoOrigen{.datos = planos[indice], .width = forma.width, .height = forma.height,
+                           .canales = forma.disposicion.canalesPorPlano,
+                           .bytesPorComponente = forma.bytesPorComponente, .filasBuffer = capacidad};
+      }
+
+    private:
+      // Filas de `bytes` bytes que empiezan en `posicion` dentro de cada búfer de `buferes`
+      static std::vector<std::span<uint8_t>> filasEn(std::span<std::vector<uint8_t>> buferes, std::size_t posicion,
+                                                     std::size_t bytes) {
+        std::vector<std::span<uint8_t>> filas;
+        for (std::vector<uint8_t> & bufer : buferes) {
+          filas.push_back(std::span<uint8_t>{bufer}.subspan(posicion, bytes));
+        }
+        return filas;
+      }
+
+      // Lee la fila `fila` del archivo, saltando las intermedias
+      void leerFilaArchivo(std::size_t fila, LectorPPMPorFilas & lector) {
+        if ((fila > leidas && !lector.saltarFilas(fila - leidas)) || !lector.leerFila(filaArchivo)) {
+          throw std::runtime_error("Error al leer los datos de la imagen.");
+        }
+        leidas = fila + 1;
+      }
+
+      void cargarFila(std::size_t fila, LectorPPMPorFilas & lector) {
+        const std::size_t posicion = (fila % capacidad) * forma.bytesFilaPlano();
+        if (diezmado.x == 1 && diezmado.y == 1) {
+          leerFilaArchivo(fila, lector);
+          const FaseMedida fase{"convert"};
+          repartirFila(filaArchivo, filasEn(planos, posicion, forma.bytesFilaPlano()), archivo);
+          return;
+        }
+        for (std::size_t muestra = 0; muestra < muestrasY.size(); ++muestra) {
+          leerFilaArchivo((fila * diezmado.y) + muestrasY[muestra], lector);
+          const FaseMedida fase{"convert"};
+          const std::span<std::vector<uint8_t>> destino{muestras};
+          repartirFila(filaArchivo, filasEn(destino.subspan(muestra * planos.size(), planos.size()), 0,
+                                            archivo.bytesFilaPlano()),
+                       archivo);
+        }
+        const FaseMedida fase{"convert"};
+        for (std::size_t plano = 0; plano < planos.size(); ++plano) {
+          const std::span<uint8_t> salida = std::span<uint8_t>{planos[plano]}.subspan(posicion, forma.bytesFilaPlano());
+          if (forma.bytesPorComponente == 1) {
+            promediarMuestras<uint8_t>(plano, salida);
+          } else {
+            promediarMuestras<uint16_t>(plano, salida);
+          }
+        }
+      }
+
+      // Media redondeada de las muestras de cada bloque del plano `plano`
+      template <typename T>
+      void promediarMuestras(std::size_t plano, std::span<uint8_t> salida) const {
+        const std::size_t canales = forma.disposicion.canalesPorPlano;
+        const auto cuenta = static_cast<uint32_t>(muestrasX.size() * muestrasY.size());
+        for (std::size_t x = 0; x < forma.width; ++x) {
+          for (std::size_t canal = 0; canal < canales; ++canal) {
+            uint32_t suma = 0;
+            for (std::size_t muestra = 0; muestra < muestrasY.size(); ++muestra) {
+              const std::vector<uint8_t> & fila = muestras[(muestra * planos.size()) + plano];
+              for (const std::size_t columna : muestrasX) {
+                suma += leerComponente<T>(fila, ((((x * diezmado.x) + columna) * canales) + canal));
+              }
+            }
+            escribirComponente<T>(salida, (x * canales) + canal, (suma + (cuenta / 2)) / cuenta);
+          }
+        }
+      }
+
+      FormaPlanos archivo;
+      FormaPlanos forma;
+      Diezmado diezmado;
+      std::vector<std::size_t> muestrasX;
+      std::vector<std::size_t> muestrasY;
+      std::size_t capacidad;
+      std::size_t cargadas = 0;
+      std::size_t leidas = 0;
+      std::vector<std::vector<uint8_t>> planos;
+      std::vector<std::vector<uint8_t>> muestras;
+      std::vector<uint8_t> filaArchivo;
+  };
+
+  // Filas de la ventana: al menos las que necesita una fila de salida y, si caben, las
+  // que ocupan BYTES_VENTANA para poder escalar franjas de varias filas a la vez
+  std::size_t capacidadVentana(PlanEscalado const & plan, FormaPlanos const & origen, std::size_t altoSalida) {
+    std::size_t necesarias = 1;
+    for (std::size_t y = 0; y < altoSalida; ++y) {
+      const RangoFilas filas = filasNecesarias(plan, y);
+      necesarias = std::max(necesarias, filas.fin - filas.inicio);
+    }
+    const std::size_t bytesFila = std::max<std::size_t>(1, origen.bytesFilaPlano() * origen.disposicion.planos);
+    return std::min(origen.height, std::max(necesarias, BYTES_VENTANA / bytesFila));
+  }
+
+  PlanEscalado crearPlan(FiltroEscalado filtro, FormaPlanos const & origen, FormaPlanos const & destino) {
+    return crearPlanEscalado(filtro,
+                             {.datos = {}, .width = origen.width, .height = origen.height,
+                              .canales = origen.disposicion.canalesPorPlano,
+                              .bytesPorComponente = origen.bytesPorComponente},
+                             {.datos = {}, .width = destino.width, .height = destino.height});
+  }
+
+  // Estado del escalado compartido por todas las franjas que pide el escritor
+  class EscaladoEnFlujo {
+    public:
+      EscaladoEnFlujo(LectorPPMPorFilas & lector, FormaPlanos origen, FormaPlanos destino, FiltroEscalado filtro)
+        : lector(lector), destino(destino), diezmado(elegirDiezmado(filtro, origen, destino)),
+          plan(crearPlan(filtro, formaDiezmada(origen, diezmado), destino)),
+          capacidad(capacidadVentana(plan, formaDiezmada(origen, diezmado), destino.height)),
+          ventana(origen, diezmado, capacidad), salida(destino.disposicion.planos) {}
+
+      // Calcula las filas de salida [rowBegin, rowEnd) en orden del archivo
+      void producir(std::span<uint8_t> franja, std::size_t rowBegin, std::size_t rowEnd) {
+        const std::size_t bytesFila = destino.bytesFilaPlano() * destino.disposicion.planos;
+        for (std::size_t inicio = rowBegin; inicio < rowEnd;) {
+          const std::size_t fin = finSubfranja(inicio, rowEnd);
+          for (std::size_t fila = inicio; fila < fin; ++fila) {
+            ventana.cargar(filasNecesarias(plan, fila), lector);
+          }
+          escalarSubfranja({.inicio = inicio, .fin = fin},
+                           franja.subspan((inicio - rowBegin) * bytesFila, (fin - inicio) * bytesFila));
+          inicio = fin;
+        }
+      }
+
+    private:
+      // Extiende la subfranja mientras todas sus filas de origen quepan en la ventana
+      [[nodiscard]] std::size_t finSubfranja(std::size_t inicio, std::size_t rowEnd) const {
+        const std::size_t primeraFuente = filasNecesarias(plan, inicio).inicio;
+        std::size_t fin = inicio + 1;
+        while (fin < rowEnd && filasNecesarias(plan, fin).fin - primeraFuente <= capacidad) {
+          ++fin;
+        }
+        return fin;
+      }
+
+      void escalarSubfranja(RangoFilas filas, std::span<uint8_t> franja) {
+        const std::size_t bytesFilaPlano = destino.bytesFilaPlano();
+        {
+          const FaseMedida fase{"kernel"};
+          for (std::size_t plano = 0; plano < salida.size(); ++plano) {
+            salida[plano].resize((filas.fin - filas.inicio) * bytesFilaPlano);
+            escalarFilas(plan, ventana.plano(plano),
+                         {.datos = salida[plano], .width = destino.width, .height = destino.height,
+                          .primeraFila = filas.inicio},
+                         filas);
+          }
+        }
+        const FaseMedida fase{"serialize"};
+        const std::size_t bytesFila = bytesFilaPlano * salida.size();
+        parallelForRows(filas.fin - filas.inicio, bytesFila, [&](std::size_t primera, std::size_t ultima) {
+          std::vector<std::span<uint8_t const>> filasPlanos(salida.size());
+          for (std::size_t fila = primera; fila < ultima; ++fila) {
+            for (std::size_t plano = 0; plano < salida.size(); ++plano) {
+              filasPlanos[plano] = std::span<uint8_t const>{salida[plano]}.subspan(fila * bytesFilaPlano, bytesFilaPlano);
+            }
+            intercalarFila(filasPlanos, franja.subspan(fila * bytesFila, bytesFila), destino);
+          }
+        });
+      }
+
+      LectorPPMPorFilas & lector;
+      FormaPlanos destino;
+      Diezmado diezmado;
+      PlanEscalado plan;
+      std::size_t capacidad;
+      VentanaFilas ventana;
+      std::vector<std::vector<uint8_t>> salida;
+  };
+}  // namespace
+
+bool escalarEnFlujo(LectorPPMPorFilas& lector, const std::string& outputFile,
+                    const OpcionesEscalado& opciones, DisposicionPlanos disposicion) {
+  const PPMAttributes& entrada = lector.atributos();
+  const std::size_t bytes = (entrada.maxValue > MAX_VALUE_8BIT) ? 2 : 1;
+  const FormaPlanos origen{.width = static_cast<std::size_t>(entrada.width),
+                           .height = static_cast<std::size_t>(entrada.height),
+                           .disposicion = disposicion, .bytesPorComponente = bytes};
+  const FormaPlanos destino{.width = static_cast<std::size_t>(opciones.width),
+                            .height = static_cast<std::size_t>(opciones.height),
+                            .disposicion = disposicion, .bytesPorComponente = bytes};
+  EscaladoEnFlujo escalado(lector, origen, destino, opciones.filtro);
+
+  const PPMAttributes salida{.width = opciones.width, .height = opciones.height, .maxValue = entrada.maxValue};
+  return escribirImagenPPMPorFilas(outputFile, salida,
+                                   [&escalado](std::span<uint8_t> franja, std::size_t rowBegin, std::size_t rowEnd) {
+                                     escalado.producir(franja, rowBegin, rowEnd);
+                                   });
+}
@@ -0,0 +1,35 @@
+// File: common/flujo.hpp
+#ifndef FLUJO_HPP
+#define FLUJO_HPP
+
+#include "binario.hpp"
+#include "escalado.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Reparto de los componentes de cada píxel en planos: un plano con los tres
+ * canales intercalados (AOS) o tres planos de un canal cada uno (SOA).
+ */
+struct DisposicionPlanos {
+  std::size_t planos;
+  std::size_t canalesPorPlano;
+};
+
+/**
+ * @brief Escala en flujo la imagen que entrega `lector` y la escribe en outputFile.
+ *
+ * Las filas de origen se leen bajo demanda en una ventana circular que solo guarda las
+ * filas que necesitan las filas de salida en curso, y cada franja de salida se escribe
+ * en cuanto se calcula, de modo que ni el origen ni el destino se cargan completos.
+ * Las filas de origen que el filtro no lee se saltan sin leerlas. En las reducciones
+ * bilineales de 4x o más, cada eje se reduce ya al cargar por una potencia de 2 (media
+ * de una muestra de 2x2 de cada bloque) y el filtro parte de esa imagen intermedia.
+ *
+ * @return false si falla la lectura o la escritura (el error se informa por std::cerr)
+ */
+bool escalarEnFlujo(LectorPPMPorFilas& lector, const std::string& outputFile,
+                    const OpcionesEscalado& opciones, DisposicionPlanos disposicion);
+
+#endif // FLUJO_HPP
@@ -0,0 +1,136 @@
+// File: common/frecuencias.cpp
+#include "frecuencias.hpp"
+
+#include "estadisticas.hpp"
+#include "imagen.hpp"
+#include "reserva.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+  using FrecuenciaColor = std::pair<ClaveColor, int>;
+  // Contenedores auxiliares de la operación, todos en la arena de la llamada
+  using MapaFrecuencias = std::pmr::unordered_map<ClaveColor, int>;
+  using MapaReemplazos = std::pmr::unordered_map<ClaveColor, ClaveColor>;
+  using ConjuntoColores = std::pmr::unordered_set<ClaveColor>;
+  constexpr std::size_t ROJO = 0;
+  constexpr std::size_t VERDE = 1;
+  constexpr std::size_t AZUL = 2;
+
+  int64_t componente(ClaveColor color, std::size_t canal) {
+    return static_cast<int64_t>(canalDeClave(color, canal));
+  }
+
+  template <typename Vista>
+  MapaFrecuencias calcularFrecuencias(const Vista& vista, std::pmr::memory_resource* memoria) {
+    MapaFrecuencias frecuencias{memoria};
+    paraCadaPixel(vista, [&](const Vista& fila, std::size_t x) { ++frecuencias[claveColor(fila, x)]; });
+    return frecuencias;
+  }
+
+  // De menos a más frecuente; a igual frecuencia, de mayor a menor azul, verde y rojo
+  std::pmr::vector<FrecuenciaColor> ordenarPorFrecuencia(const MapaFrecuencias& frecuencias) {
+    std::pmr::vector<FrecuenciaColor> ordenados(frecuencias.begin(), frecuencias.end(), frecuencias.get_allocator());
+    std::ranges::sort(ordenados, [](const FrecuenciaColor& colorA, const FrecuenciaColor& colorB) {
+      if (colorA.second != colorB.second) {
+        return colorA.second < colorB.second;
+      }
+      for (const std::size_t canal : {AZUL, VERDE, ROJO}) {
+        if (componente(colorA.first, canal) != componente(colorB.first, canal)) {
+          return componente(colorA.first, canal) > componente(colorB.first, canal);
+        }
+      }
+      return false;
+    });
+    return ordenados;
+  }
+
+  int64_t distanciaCuadrada(ClaveColor colorA, ClaveColor colorB) {
+    int64_t distancia = 0;
+    for (const std::size_t canal : {ROJO, VERDE, AZUL}) {
+      const int64_t diferencia = componente(colorA, canal) - componente(colorB, canal);
+      distancia += diferencia * diferencia;
+    }
+    return distancia;
+  }
+
+  // Color restante más cercano a cada color eliminado; a igual distancia, el primero en `ordenados`
+  MapaReemplazos encontrarReemplazos(const ConjuntoColores& eliminados, const std::pmr::vector<FrecuenciaColor>& ordenados) {
+    std::pmr::vector<ClaveColor> candidatos{ordenados.get_allocator()};
+    for (const auto& [color, frecuencia] : ordenados) {
+      if (!eliminados.contains(color)) {
+        candidatos.push_back(color);
+      }
+    }
+    MapaReemplazos reemplazos{ordenados.get_allocator()};
+    for (const ClaveColor eliminado : eliminados) {
+      ClaveColor cercano = 0;
+      int64_t minima = std::numeric_limits<int64_t>::max();
+      for (const ClaveColor candidato : candidatos) {
+        const int64_t distancia = distanciaCuadrada(eliminado, candidato);
+        if (distancia < minima) {
+          minima = distancia;
+          cercano = candidato;
+        }
+      }
+      reemplazos[eliminado] = cercano;
+    }
+    return reemplazos;
+  }
+
+  template <typename Vista>
+  void reemplazarColores(const Vista& vista, const MapaReemplazos& reemplazos) {
+    paraCadaPixel(vista, [&](const Vista& fila, std::size_t x) {
+      const auto encontrado = reemplazos.find(claveColor(fila, x));
+      if (encontrado != reemplazos.end()) {
+        for (const std::size_t canal : {ROJO, VERDE, AZUL}) {
+          fila.escribir(x, canal, static_cast<uint32_t>(componente(encontrado->second, canal)));
+        }
+      }
+    });
+  }
+
+  template <typename Vista>
+  void recortarVista(const Vista& vista, int n) {
+    ArenaTemporal arena;
+    const MapaFrecuencias frecuencias = calcularFrecuencias(vista, &arena);
+    if (frecuencias.size() <= 1 || n == 0) {
+      return;  // No hay nada que reemplazar
+    }
+    const std::pmr::vector<FrecuenciaColor> ordenados = ordenarPorFrecuencia(frecuencias);
+    // Siempre queda al menos el color más frecuente, para que haya con qué reemplazar
+    const std::size_t cuantos = std::min(static_cast<std::size_t>(n), ordenados.size() - 1);
+    ConjuntoColores eliminados{&arena};
+    for (std::size_t i = 0; i < cuantos; ++i) {
+      eliminados.insert(ordenados[i].first);
+    }
+    reemplazarColores(vista, encontrarReemplazos(eliminados, ordenados));
+  }
+
+  template <typename Imagen>
+  void recortar(Imagen& image, int n) {
+    if (n < 0) {
+      throw std::invalid_argument("Invalid number of colors to cut: " + std::to_string(n));
+    }
+    const FaseMedida fase{"kernel"};
+    segunProfundidad(image.maxValue, [&]<typename T>(T) { recortarVista(vistaImagen<T>(image), n); });
+  }
+}  // namespace
+
+void eliminarColoresMenosFrecuentes(PPMImage& image, int n) {
+  recortar(image, n);
+}
+
+void eliminarColoresMenosFrecuentes(PPMImageSoA& image, int n) {
+  recortar(image, n);
+}
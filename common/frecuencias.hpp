@@ -0,0 +1,21 @@
+// File: common/frecuencias.hpp
+#ifndef FRECUENCIAS_HPP
+#define FRECUENCIAS_HPP
+
+#include "binario.hpp"
+
+/**
+ * @brief Operación cutfreq, escrita una sola vez sobre VistaImagen para AOS y SOA.
+ *
+ * Sustituye los n colores menos frecuentes (a igual frecuencia, primero los de mayor
+ * azul, luego verde y luego rojo) por el color restante más cercano en distancia
+ * euclídea RGB. Si la imagen tiene un solo color o n es 0, no cambia nada; si n no es
+ * menor que el número de colores, se conserva solo el más frecuente y toda la imagen
+ * queda de ese color. Admite componentes de 8 y de 16 bits.
+ *
+ * @throws std::invalid_argument si n es negativo.
+ */
+void eliminarColoresMenosFrecuentes(PPMImage& image, int n);
+void eliminarColoresMenosFrecuentes(PPMImageSoA& image, int n);
+
+#endif // FRECUENCIAS_HPP
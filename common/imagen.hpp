@@ -0,0 +1,236 @@
+// File: common/imagen.hpp
+#ifndef IMAGEN_HPP
+#define IMAGEN_HPP
+
+#include "binario.hpp"
+#include "reserva.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Disposición de los componentes en memoria: intercalada (AOS, RGBRGB...) o
+ * planar (SOA, un plano por canal).
+ */
+struct Intercalada {};
+struct Planar {};
+
+constexpr std::size_t CANALES_RGB = 3;
+constexpr int MAX_VALOR_8BIT = 255;
+
+/**
+ * @brief Almacenamiento de componentes de tipo T (uint8_t o uint16_t) de una imagen AOS
+ * y planos (0 rojo, 1 verde, 2 azul) de una imagen SOA.
+ */
+template <typename T>
+VectorReserva<T>& componentes(PPMImage& image) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return image.pixelData;
+  } else {
+    return image.pixelData16;
+  }
+}
+
+template <typename T>
+const VectorReserva<T>& componentes(const PPMImage& image) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return image.pixelData;
+  } else {
+    return image.pixelData16;
+  }
+}
+
+template <typename T>
+PlanosAlineados<T>& canales(PPMImageSoA& image) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return image.planos;
+  } else {
+    return image.planos16;
+  }
+}
+
+template <typename T>
+const PlanosAlineados<T>& canales(const PPMImageSoA& image) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return image.planos;
+  } else {
+    return image.planos16;
+  }
+}
+
+/**
+ * @brief Da a la imagen almacenamiento de tipo T, a cero, para ancho x alto píxeles.
+ */
+template <typename T>
+void dimensionarComponentes(PPMImage& image, std::size_t ancho, std::size_t alto) {
+  componentes<T>(image).assign(ancho * alto * CANALES_RGB, 0);
+}
+
+template <typename T>
+void dimensionarComponentes(PPMImageSoA& image, std::size_t ancho, std::size_t alto) {
+  canales<T>(image) = PlanosAlineados<T>(ancho, alto);
+}
+
+/**
+ * @brief Vista sin propiedad de una imagen RGB con componentes de tipo Elemento
+ * (uint8_t o uint16_t, `const` en las vistas de solo lectura) en la disposición indicada.
+ *
+ * Las operaciones comunes a AOS y SOA se escriben una sola vez sobre esta vista y se
+ * especializan al compilar para cada disposición y profundidad. Los componentes se leen
+ * y escriben como palabras nativas, sin recomponerlos byte a byte. Las filas de cada
+ * canal empiezan cada paso() componentes, así que entre ellas puede haber relleno (los
+ * planos SOA, planos.hpp); las operaciones recorren la imagen fila a fila con fila().
+ */
+template <typename Disposicion, typename Elemento>
+class VistaImagen {
+  public:
+  using Componente = std::remove_const_t<Elemento>;
+  using Canales = std::array<std::span<Elemento>, CANALES_RGB>;
+
+  // Componentes entre dos píxeles consecutivos de un mismo canal
+  static constexpr std::size_t PASO = std::is_same_v<Disposicion, Intercalada> ? CANALES_RGB : 1;
+  // Si todos los componentes de una fila están seguidos en un único búfer
+  static constexpr bool CONTIGUA = std::is_same_v<Disposicion, Intercalada>;
+
+  // `canales` empieza en la primera fila de cada canal; `paso` en componentes
+  VistaImagen(Canales canales, std::size_t ancho, std::size_t alto, std::size_t paso)
+      : canales{canales}, anchoVista{ancho}, altoVista{alto}, pasoFila{paso} {}
+
+  [[nodiscard]] std::size_t ancho() const { return anchoVista; }
+  [[nodiscard]] std::size_t alto() const { return altoVista; }
+  [[nodiscard]] std::size_t pixeles() const { return anchoVista * altoVista; }
+
+  // Píxel x de la primera fila de la vista
+  [[nodiscard]] uint32_t leer(std::size_t x, std::size_t canal) const { return canales[canal][x * PASO]; }
+
+  void escribir(std::size_t x, std::size_t canal, uint32_t valor) const
+    requires(!std::is_const_v<Elemento>)
+  {
+    canales[canal][x * PASO] = static_cast<Componente>(valor);
+  }
+
+  // Componente `indice` de la primera fila en el orden de memoria (solo en la
+  // disposición intercalada)
+  [[nodiscard]] uint32_t leerEnOrden(std::size_t indice) const
+    requires CONTIGUA
+  {
+    return canales[0][indice];
+  }
+
+  void escribirEnOrden(std::size_t indice, uint32_t valor) const
+    requires(CONTIGUA && !std::is_const_v<Elemento>)
+  {
+    canales[0][indice] = static_cast<Componente>(valor);
+  }
+
+  // Vista de las filas [primera, primera + cuantas)
+  [[nodiscard]] VistaImagen subvista(std::size_t primera, std::size_t cuantas) const {
+    const std::size_t desplazamiento = primera * pasoFila;
+    const auto desde = [desplazamiento](std::span<Elemento> canal) {
+      return canal.subspan(std::min(desplazamiento, canal.size()));
+    };
+    return VistaImagen{{desde(canales[0]), desde(canales[1]), desde(canales[2])}, anchoVista, cuantas, pasoFila};
+  }
+
+  // Vista de la fila y
+  [[nodiscard]] VistaImagen fila(std::size_t y) const { return subvista(y, 1); }
+
+  private:
+  Canales canales;
+  std::size_t anchoVista;
+  std::size_t altoVista;
+  std::size_t pasoFila;
+};
+
+/**
+ * @brief Vista intercalada sobre un búfer de filas de `ancho` píxeles RGB seguidas, en
+ * orden de memoria; el número de filas sale del tamaño del búfer.
+ */
+template <typename Elemento>
+VistaImagen<Intercalada, Elemento> vistaIntercalada(std::span<Elemento> datos, std::size_t ancho) {
+  const auto desde = [datos](std::size_t canal) { return datos.subspan(std::min(datos.size(), canal)); };
+  const std::size_t paso = ancho * CANALES_RGB;
+  return {{datos, desde(1), desde(2)}, ancho, (paso == 0) ? 0 : datos.size() / paso, paso};
+}
+
+/**
+ * @brief Vistas de las imágenes AOS y SOA sobre el almacenamiento de componentes de
+ * tipo T. En AOS el número de filas sale del tamaño del almacenamiento y de width; en SOA,
+ * de las dimensiones de los planos.
+ */
+template <typename T>
+VistaImagen<Intercalada, T> vistaImagen(PPMImage& image) {
+  return vistaIntercalada(std::span<T>{componentes<T>(image)}, static_cast<std::size_t>(image.width));
+}
+
+template <typename T>
+VistaImagen<Intercalada, T const> vistaImagen(const PPMImage& image) {
+  return vistaIntercalada(std::span<T const>{componentes<T>(image)}, static_cast<std::size_t>(image.width));
+}
+
+template <typename T>
+VistaImagen<Planar, T> vistaImagen(PPMImageSoA& image) {
+  PlanosAlineados<T>& planos = canales<T>(image);
+  return {{planos.plano(0), planos.plano(1), planos.plano(2)}, planos.ancho(), planos.alto(), planos.paso()};
+}
+
+template <typename T>
+VistaImagen<Planar, T const> vistaImagen(const PPMImageSoA& image) {
+  const PlanosAlineados<T>& planos = canales<T>(image);
+  return {{planos.plano(0), planos.plano(1), planos.plano(2)}, planos.ancho(), planos.alto(), planos.paso()};
+}
+
+/**
+ * @brief Llama a funcion(fila, x) para cada píxel de la vista, fila a fila.
+ */
+template <typename Vista, typename Funcion>
+void paraCadaPixel(const Vista& vista, Funcion&& funcion) {
+  for (std::size_t y = 0; y < vista.alto(); ++y) {
+    const Vista fila = vista.fila(y);
+    for (std::size_t x = 0; x < fila.ancho(); ++x) {
+      funcion(fila, x);
+    }
+  }
+}
+
+/**
+ * @brief Color de un píxel empaquetado con 16 bits por canal, el rojo en los bits altos:
+ * el orden numérico de las claves es el orden lexicográfico (rojo, verde, azul).
+ */
+using ClaveColor = uint64_t;
+constexpr unsigned int BITS_CANAL_CLAVE = 16;
+constexpr ClaveColor MASCARA_CANAL_CLAVE = 0xFFFF;
+
+template <typename Vista>
+ClaveColor claveColor(const Vista& vista, std::size_t pixel) {
+  return (ClaveColor{vista.leer(pixel, 0)} << (2 * BITS_CANAL_CLAVE)) |
+         (ClaveColor{vista.leer(pixel, 1)} << BITS_CANAL_CLAVE) | ClaveColor{vista.leer(pixel, 2)};
+}
+
+/**
+ * @brief Componente del canal `canal` (0 rojo, 1 verde, 2 azul) de una clave de color.
+ */
+inline uint32_t canalDeClave(ClaveColor color, std::size_t canal) {
+  return static_cast<uint32_t>((color >> ((CANALES_RGB - 1 - canal) * BITS_CANAL_CLAVE)) & MASCARA_CANAL_CLAVE);
+}
+
+/**
+ * @brief Llama a `funcion` con un valor del tipo de componente que corresponde a
+ * maxValue (uint8_t hasta 255, uint16_t por encima), para elegir la especialización
+ * una sola vez por imagen.
+ */
+template <typename Funcion>
+decltype(auto) segunProfundidad(int maxValue, Funcion&& funcion) {
+  if (maxValue > MAX_VALOR_8BIT) {
+    return std::forward<Funcion>(funcion)(uint16_t{});
+  }
+  return std::forward<Funcion>(funcion)(uint8_t{});
+}
+
+#endif // IMAGEN_HPP
@@ -0,0 +1,62 @@
+// File: common/isa.cpp
+#include "isa.hpp"
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  std::optional<NivelISA> nivelForzado;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  NivelISA detectar() {
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl")) {
+      return NivelISA::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("fma")) {
+      return NivelISA::avx2;
+    }
+#endif
+    return NivelISA::base;
+  }
+}  // namespace
+
+NivelISA nivelISADetectado() {
+  static const NivelISA detectado = detectar();
+  return detectado;
+}
+
+NivelISA nivelISA() {
+  return nivelForzado.value_or(nivelISADetectado());
+}
+
+void forzarNivelISA(NivelISA nivel) {
+  if (nivel > nivelISADetectado()) {
+    throw std::invalid_argument(std::string("ISA level not supported by this CPU: ") + nombreNivelISA(nivel));
+  }
+  nivelForzado = nivel;
+}
+
+NivelISA leerNivelISA(const std::string& nombre) {
+  if (nombre == "baseline") {
+    return NivelISA::base;
+  }
+  if (nombre == "avx2") {
+    return NivelISA::avx2;
+  }
+  if (nombre == "avx512") {
+    return NivelISA::avx512;
+  }
+  throw std::invalid_argument("Invalid ISA level: " + nombre);
+}
+
+const char* nombreNivelISA(NivelISA nivel) {
+  switch (nivel) {
+    case NivelISA::avx512: return "avx512";
+    case NivelISA::avx2: return "avx2";
+    case NivelISA::base: break;
+  }
+  return "baseline";
+}
@@ -0,0 +1,90 @@
+// File: common/isa.hpp
+#ifndef ISA_HPP
+#define ISA_HPP
+
+#include <string>
+
+/**
+ * @brief Juegos de instrucciones para los que se compilan los núcleos críticos.
+ *
+ * - base: x86-64 (SSE2) o la arquitectura de destino sin extensiones.
+ * - avx2: AVX2, BMI2 y FMA (Haswell y posteriores).
+ * - avx512: además AVX-512 F, BW y VL (Skylake-SP y posteriores).
+ */
+enum class NivelISA { base, avx2, avx512 };
+
+/**
+ * @brief Nivel más alto que admite el procesador (siempre base fuera de x86-64).
+ */
+[[nodiscard]] NivelISA nivelISADetectado();
+
+/**
+ * @brief Nivel con el que se eligen los núcleos: el forzado con forzarNivelISA o, si
+ * no se forzó, el detectado.
+ */
+[[nodiscard]] NivelISA nivelISA();
+
+/**
+ * @brief Fuerza un nivel (--isa=), por ejemplo para comparar o probar las variantes.
+ * Debe llamarse antes de ejecutar la operación.
+ *
+ * @throws std::invalid_argument si el procesador no admite ese nivel.
+ */
+void forzarNivelISA(NivelISA nivel);
+
+/**
+ * @brief Traduce el nombre de un nivel ("baseline", "avx2" o "avx512").
+ * @throws std::invalid_argument si el nombre no corresponde a ningún nivel.
+ */
+NivelISA leerNivelISA(const std::string& nombre);
+
+/**
+ * @brief Nombre del nivel, el mismo que acepta leerNivelISA.
+ */
+[[nodiscard]] const char* nombreNivelISA(NivelISA nivel);
+
+// Atributos de las variantes de cada núcleo. Las funciones con estos atributos se
+// compilan para ese juego de instrucciones aunque el resto del programa no lo use,
+// y solo se llaman si nivelISA() lo permite. Fuera de x86-64 con GCC o Clang no
+// tienen efecto y las tres variantes son iguales.
+#if defined(__x86_64__) && defined(__GNUC__)
+// Los núcleos con intrínsecos de x86 se compilan solo si está definida
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define IMTOOL_VARIANTES_X86 1
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define IMTOOL_DESTINO_AVX2 __attribute__((target("avx2,bmi2,fma")))
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define IMTOOL_DESTINO_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi2,fma")))
+#else
+#define IMTOOL_DESTINO_AVX2
+#define IMTOOL_DESTINO_AVX512
+#endif
+
+/**
+ * @brief Las tres variantes de un núcleo. Cada módulo escribe el cuerpo una sola vez
+ * en una función [[gnu::always_inline]] y lo envuelve en una función por nivel; la
+ * función con el atributo IMTOOL_DESTINO_* recibe el cuerpo ya integrado y lo
+ * vectoriza con esas instrucciones.
+ */
+template <typename Funcion>
+struct VariantesISA {
+  Funcion base;
+  Funcion avx2;
+  Funcion avx512;
+};
+
+/**
+ * @brief Variante que corresponde a nivelISA(). Basta con llamarla una vez por imagen
+ * o por franja y guardar el puntero.
+ */
+template <typename Funcion>
+Funcion elegirVariante(const VariantesISA<Funcion>& variantes) {
+  switch (nivelISA()) {
+    case NivelISA::avx512: return variantes.avx512;
+    case NivelISA::avx2: return variantes.avx2;
+    case NivelISA::base: break;
+  }
+  return variantes.base;
+}
+
+#endif // ISA_HPP
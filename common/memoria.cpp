@@ -0,0 +1,161 @@
+// File: common/memoria.cpp
+#include "memoria.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#if defined(IMTOOL_CONTAR_MEMORIA) && defined(__GLIBC__)
+#include <malloc.h>
+#define IMTOOL_OPERATOR_NEW_CONTADO
+#endif
+
+namespace {
+  // Se usan antes de main (reservas de otros objetos estáticos): se inicializan en compilación
+  constinit std::atomic<bool> activo{false};                 // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  constinit std::atomic<std::uint64_t> bytesTotales{0};      // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  constinit std::atomic<std::uint64_t> asignacionesTotales{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  constinit std::atomic<std::int64_t> bytesVivos{0};         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  constinit std::atomic<std::int64_t> picoVivos{0};          // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  void actualizarPico(std::int64_t valor) {
+    std::int64_t actual = picoVivos.load(std::memory_order_relaxed);
+    while (valor > actual && !picoVivos.compare_exchange_weak(actual, valor, std::memory_order_relaxed)) {
+    }
+  }
+
+#ifdef IMTOOL_OPERATOR_NEW_CONTADO
+  // Se cuenta el tamaño real del bloque de malloc, que es también el que se libera; con el
+  // contador inactivo no se consulta, para no pagar malloc_usable_size en cada reserva
+  void * reservar(std::size_t bytes, std::size_t alineacion) {
+    const std::size_t pedido = (bytes == 0) ? 1 : bytes;
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+    void * bloque = (alineacion == 0) ? std::malloc(pedido)
+                                      : std::aligned_alloc(alineacion, (pedido + alineacion - 1) / alineacion * alineacion);
+    if (bloque == nullptr) {
+      throw std::bad_alloc();
+    }
+    if (activo.load(std::memory_order_relaxed)) {
+      registrarAsignacion(malloc_usable_size(bloque));
+    }
+    return bloque;
+  }
+
+  void liberar(void * bloque) noexcept {
+    if (bloque == nullptr) {
+      return;
+    }
+    if (activo.load(std::memory_order_relaxed)) {
+      registrarLiberacion(malloc_usable_size(bloque));
+    }
+    std::free(bloque);  // NOLINT(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+  }
+#endif
+}  // namespace
+
+#ifdef IMTOOL_OPERATOR_NEW_CONTADO
+// libstdc++ implementa las versiones de arrays y nothrow sobre estas
+void * operator new(std::size_t bytes) {
+  return reservar(bytes, 0);
+}
+
+void * operator new(std::size_t bytes, std::align_val_t alineacion) {
+  return reservar(bytes, static_cast<std::size_t>(alineacion));
+}
+
+void operator delete(void * bloque) noexcept {
+  liberar(bloque);
+}
+
+void operator delete(void * bloque, std::size_t /*bytes*/) noexcept {
+  liberar(bloque);
+}
+
+void operator delete(void * bloque, std::align_val_t /*alineacion*/) noexcept {
+  liberar(bloque);
+}
+
+void operator delete(void * bloque, std::size_t /*bytes*/, std::align_val_t /*alineacion*/) noexcept {
+  liberar(bloque);
+}
+#endif
+
+void activarContadorMemoria() {
+  activo.store(true, std::memory_order_relaxed);
+}
+
+bool contadorMemoriaGlobal() {
+#ifdef IMTOOL_OPERATOR_NEW_CONTADO
+  return true;
+#else
+  return false;
+#endif
+}
+
+void registrarAsignacion(std::size_t bytes) {
+  if (!activo.load(std::memory_order_relaxed)) {
+    return;
+  }
+  bytesTotales.fetch_add(bytes, std::memory_order_relaxed);
+  asignacionesTotales.fetch_add(1, std::memory_order_relaxed);
+  const auto cantidad = static_cast<std::int64_t>(bytes);
+  actualizarPico(bytesVivos.fetch_add(cantidad, std::memory_order_relaxed) + cantidad);
+}
+
+void registrarLiberacion(std::size_t bytes) {
+  if (activo.load(std::memory_order_relaxed)) {
+    bytesVivos.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+  }
+}
+
+LecturaMemoria leerMemoria() {
+  return {.bytes = bytesTotales.load(std::memory_order_relaxed),
+          .asignaciones = asignacionesTotales.load(std::memory_order_relaxed),
+          .vivos = bytesVivos.load(std::memory_order_relaxed),
+          .pico = picoVivos.load(std::memory_order_relaxed)};
+}
+
+std::int64_t reiniciarPico() {
+  return picoVivos.exchange(bytesVivos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void restaurarPico(std::int64_t anterior) {
+  actualizarPico(anterior);
+}
+
+std::uint64_t paginasGrandesKiB() {
+#ifdef __linux__
+  // smaps_rollup suma todas las regiones del proceso; la línea es "AnonHugePages: N kB"
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  const std::string campo = "AnonHugePages:";
+  std::string clave;
+  while (smaps >> clave) {
+    if (clave == campo) {
+      std::uint64_t kib = 0;
+      smaps >> kib;
+      return kib;
+    }
+    smaps.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+#endif
+  return 0;
+}
+
+std::uint64_t residenteMaximoKiB() {
+#ifdef __linux__
+  rusage uso{};
+  if (getrusage(RUSAGE_SELF, &uso) == 0 && uso.ru_maxrss > 0) {
+    return static_cast<std::uint64_t>(uso.ru_maxrss);
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,67 @@
+// File: common/memoria.hpp
+#ifndef MEMORIA_HPP
+#define MEMORIA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Memoria reservada desde activarContadorMemoria: bytes y número de reservas
+ * acumulados, bytes vivos en este momento y máximo de bytes vivos (pico).
+ */
+struct LecturaMemoria {
+  std::uint64_t bytes;
+  std::uint64_t asignaciones;
+  std::int64_t vivos;
+  std::int64_t pico;
+};
+
+/**
+ * @brief Empieza a contar las reservas de memoria. Con IMTOOL_CONTAR_MEMORIA (opción
+ * IMTOOL_MEMORY_HOOK de CMake) se sustituye el operator new global, de modo que se
+ * cuentan todas las reservas del proceso; sin ella solo se cuenta lo que se notifique con
+ * registrarAsignacion, que hace la reserva de búferes (reserva.hpp) con cada búfer de
+ * imagen y cada bloque de memoria auxiliar.
+ *
+ * La memoria reservada antes de activar el contador y liberada después descuenta de los
+ * bytes vivos, así que conviene activarlo al principio del programa.
+ */
+void activarContadorMemoria();
+
+/**
+ * @brief Si el operator new global está sustituido (si no, los contadores solo incluyen
+ * las reservas notificadas, como las de la reserva de búferes).
+ */
+[[nodiscard]] bool contadorMemoriaGlobal();
+
+/**
+ * @brief Notifica una reserva o liberación hecha fuera de operator new (la reserva de
+ * búferes, o memoria obtenida con mmap). No hace nada si el contador no está activo.
+ */
+void registrarAsignacion(std::size_t bytes);
+void registrarLiberacion(std::size_t bytes);
+
+[[nodiscard]] LecturaMemoria leerMemoria();
+
+/**
+ * @brief Reinicia el pico a los bytes vivos actuales y devuelve el anterior, para medir
+ * el pico de una fase; restaurarPico lo vuelve a combinar al cerrarla. Si varias fases
+ * se solapan en distintos hilos, el pico de cada una es aproximado.
+ */
+std::int64_t reiniciarPico();
+void restaurarPico(std::int64_t anterior);
+
+/**
+ * @brief Máximo de memoria residente del proceso (ru_maxrss) en KiB; 0 si el sistema no
+ * lo ofrece.
+ */
+[[nodiscard]] std::uint64_t residenteMaximoKiB();
+
+/**
+ * @brief Memoria anónima del proceso respaldada ahora mismo por páginas grandes
+ * transparentes (AnonHugePages de /proc/self/smaps_rollup) en KiB; 0 si no hay o el
+ * sistema no lo ofrece.
+ */
+[[nodiscard]] std::uint64_t paginasGrandesKiB();
+
+#endif // MEMORIA_HPP
@@ -0,0 +1,182 @@
+// File: common/niveles.cpp
+#include "niveles.hpp"
+
+#include "estadisticas.hpp"
+#include "imagen.hpp"
+#include "isa.hpp"
+#include "nucleos.hpp"
+#include "parallel.hpp"
+#include "reserva.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+  constexpr int MAX_VALOR_16BIT = 65535;
+  constexpr std::size_t TAMANO_TABLA_8BIT = 256;
+  constexpr std::size_t TAMANO_TABLA_16BIT = 65536;
+
+  // Valor escalado y limitado de cada posible componente de entrada
+  std::pmr::vector<uint16_t> tablaNiveles(int maxValue, int nuevoMaximo, std::pmr::memory_resource* memoria) {
+    const std::size_t tamano = (maxValue > MAX_VALOR_8BIT) ? TAMANO_TABLA_16BIT : TAMANO_TABLA_8BIT;
+    const double factor = static_cast<double>(nuevoMaximo) / maxValue;
+    const auto limite = static_cast<unsigned int>(nuevoMaximo);
+    std::pmr::vector<uint16_t> tabla(tamano, memoria);
+    for (std::size_t valor = 0; valor < tamano; ++valor) {
+      const auto escalado = static_cast<unsigned int>(std::lround(static_cast<double>(valor) * factor));
+      tabla[valor] = static_cast<uint16_t>(std::min(escalado, limite));
+    }
+    return tabla;
+  }
+
+  // Cuerpo del núcleo, especializado al compilar para cada disposición y profundidad de
+  // origen y destino. Admite que ambos sean el mismo almacenamiento si el tipo no cambia.
+  template <typename Origen, typename Destino>
+  [[gnu::always_inline]] inline void escalarCuerpo(Origen const & origenVista, Destino const & destinoVista,
+                                                   std::span<uint16_t const> tablaNiveles) {
+    // Copias locales: así escribir en el destino no puede modificar las vistas y el bucle se vectoriza
+    const Origen origen = origenVista;
+    const Destino destino = destinoVista;
+    const std::span<uint16_t const> tabla = tablaNiveles;
+    for (std::size_t y = 0; y < origen.alto(); ++y) {
+      const Origen filaOrigen = origen.fila(y);
+      const Destino filaDestino = destino.fila(y);
+      if constexpr (Origen::CONTIGUA && Destino::CONTIGUA) {
+        // Ambas intercaladas: un único recorrido sobre todos los componentes de la fila
+        for (std::size_t i = 0; i < filaOrigen.ancho() * CANALES_RGB; ++i) {
+          filaDestino.escribirEnOrden(i, tabla[filaOrigen.leerEnOrden(i)]);
+        }
+      } else {
+        for (std::size_t canal = 0; canal < CANALES_RGB; ++canal) {
+          for (std::size_t x = 0; x < filaOrigen.ancho(); ++x) {
+            filaDestino.escribir(x, canal, tabla[filaOrigen.leer(x, canal)]);
+          }
+        }
+      }
+    }
+  }
+
+  // Una variante del núcleo por nivel de instrucciones (isa.hpp)
+  template <typename Origen, typename Destino>
+  using NucleoNiveles = void (*)(Origen const &, Destino const &, std::span<uint16_t const>);
+
+  template <typename Origen, typename Destino>
+  void escalarBase(Origen const & origen, Destino const & destino, std::span<uint16_t const> tabla) {
+    escalarCuerpo(origen, destino, tabla);
+  }
+
+  template <typename Origen, typename Destino>
+  IMTOOL_DESTINO_AVX2 void escalarAvx2(Origen const & origen, Destino const & destino,
+                                       std::span<uint16_t const> tabla) {
+    escalarCuerpo(origen, destino, tabla);
+  }
+
+  template <typename Origen, typename Destino>
+  IMTOOL_DESTINO_AVX512 void escalarAvx512(Origen const & origen, Destino const & destino,
+                                           std::span<uint16_t const> tabla) {
+    escalarCuerpo(origen, destino, tabla);
+  }
+
+  template <typename Origen, typename Destino>
+  constexpr VariantesISA<NucleoNiveles<Origen, Destino>> ESCALAR{.base = &escalarBase<Origen, Destino>,
+                                                                 .avx2 = &escalarAvx2<Origen, Destino>,
+                                                                 .avx512 = &escalarAvx512<Origen, Destino>};
+
+  // Escala origen sobre destino (los mismos píxeles) repartiendo las filas entre hilos
+  template <typename Origen, typename Destino>
+  void escalarFilas(Origen const & origen, Destino const & destino, std::span<uint16_t const> tabla) {
+    if (origen.ancho() == 0) {
+      return;
+    }
+    const NucleoNiveles<Origen, Destino> nucleo = elegirVariante(ESCALAR<Origen, Destino>);
+    parallelForRows(origen.alto(), origen.ancho() * CANALES_RGB, [&](std::size_t primera, std::size_t ultima) {
+      nucleo(origen.subvista(primera, ultima - primera), destino.subvista(primera, ultima - primera), tabla);
+    });
+  }
+
+  // Imagen vacía con la forma de `image` y las dimensiones de `vista`, con componentes de tipo T
+  template <typename T, typename Imagen, typename Vista>
+  Imagen imagenComo(const Imagen& image, const Vista& vista) {
+    Imagen resultado{{.width = image.width, .height = image.height, .maxValue = image.maxValue}};
+    dimensionarComponentes<T>(resultado, vista.ancho(), vista.alto());
+    return resultado;
+  }
+
+  template <typename Imagen>
+  void aplicarEnMemoria(Imagen& image, int nuevoMaximo) {
+    validarNivelMaximo(nuevoMaximo);
+    const FaseMedida fase{"kernel"};
+    ArenaTemporal arena;
+    const std::pmr::vector<uint16_t> tabla = tablaNiveles(image.maxValue, nuevoMaximo, &arena);
+    segunProfundidad(image.maxValue, [&]<typename Entrada>(Entrada) {
+      segunProfundidad(nuevoMaximo, [&]<typename Salida>(Salida) {
+        const auto origen = vistaImagen<Entrada>(std::as_const(image));
+        if constexpr (std::is_same_v<Entrada, Salida>) {
+          escalarFilas(origen, vistaImagen<Salida>(image), tabla);
+        } else {
+          Imagen escalada = imagenComo<Salida>(image, origen);
+          escalarFilas(origen, vistaImagen<Salida>(escalada), tabla);
+          image = std::move(escalada);
+        }
+      });
+    });
+    image.maxValue = nuevoMaximo;
+  }
+
+  template <typename Imagen>
+  bool escribirEnFlujo(const std::string& filePath, const Imagen& image, int nuevoMaximo) {
+    validarNivelMaximo(nuevoMaximo);
+    ArenaTemporal arena;
+    const std::pmr::vector<uint16_t> tabla = tablaNiveles(image.maxValue, nuevoMaximo, &arena);
+    const auto width = static_cast<std::size_t>(image.width);
+    std::pmr::vector<uint16_t> franja16{recursoReserva()};
+    const ProductorFilas productor = [&](std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd) {
+      const FaseMedida fase{"kernel"};
+      segunProfundidad(image.maxValue, [&]<typename Entrada>(Entrada) {
+        const auto origen = vistaImagen<Entrada>(image).subvista(rowBegin, rowEnd - rowBegin);
+        if (nuevoMaximo <= MAX_VALOR_8BIT) {
+          escalarFilas(origen, vistaIntercalada(destino, width), tabla);
+          return;
+        }
+        // En el archivo los componentes de 16 bits van con el byte alto primero: se escalan
+        // en palabras nativas y se copian intercambiando los bytes
+        franja16.resize(destino.size() / 2);
+        escalarFilas(origen, vistaIntercalada(std::span<uint16_t>{franja16}, width), tabla);
+        copiarIntercambiando16(bytesDe(std::span<uint16_t>{franja16}), destino);
+      });
+    };
+    return escribirImagenPPMPorFilas(filePath, {.width = image.width, .height = image.height, .maxValue = nuevoMaximo},
+                                     productor);
+  }
+}  // namespace
+
+void validarNivelMaximo(int nuevoMaximo) {
+  if (nuevoMaximo <= 0 || nuevoMaximo > MAX_VALOR_16BIT) {
+    throw std::invalid_argument("Nuevo valor máximo fuera de rango válido (1-65535)");
+  }
+}
+
+void aplicarNivelMaximo(PPMImage& image, int nuevoMaximo) {
+  aplicarEnMemoria(image, nuevoMaximo);
+}
+
+void aplicarNivelMaximo(PPMImageSoA& image, int nuevoMaximo) {
+  aplicarEnMemoria(image, nuevoMaximo);
+}
+
+bool escribirNivelMaximo(const std::string& filePath, const PPMImage& image, int nuevoMaximo) {
+  return escribirEnFlujo(filePath, image, nuevoMaximo);
+}
+
+bool escribirNivelMaximo(const std::string& filePath, const PPMImageSoA& image, int nuevoMaximo) {
+  return escribirEnFlujo(filePath, image, nuevoMaximo);
+}
@@ -0,0 +1,38 @@
+// File: common/niveles.hpp
+#ifndef NIVELES_HPP
+#define NIVELES_HPP
+
+#include "binario.hpp"
+
+#include <string>
+
+/**
+ * @brief Operación maxlevel, escrita una sola vez sobre VistaImagen para AOS y SOA.
+ *
+ * Cada componente se escala con una tabla precalculada, round(v * nuevo / max),
+ * limitada a nuevoMaximo; la imagen resultante tiene nuevoMaximo como valor máximo.
+ */
+
+/**
+ * @brief Comprueba que nuevoMaximo esté en el rango 1-65535.
+ * @throws std::invalid_argument si no lo está.
+ */
+void validarNivelMaximo(int nuevoMaximo);
+
+/**
+ * @brief Cambia el valor máximo de una imagen en memoria. Si la profundidad (8 o 16 bits)
+ * no cambia, escala sobre el propio almacenamiento de la imagen.
+ * @throws std::invalid_argument si nuevoMaximo está fuera de rango.
+ */
+void aplicarNivelMaximo(PPMImage& image, int nuevoMaximo);
+void aplicarNivelMaximo(PPMImageSoA& image, int nuevoMaximo);
+
+/**
+ * @brief Escribe en filePath la imagen con el nuevo valor máximo. Los valores escalados
+ * se generan directamente en el búfer de escritura, sin imagen de salida intermedia.
+ * @return false si falla la escritura.
+ */
+bool escribirNivelMaximo(const std::string& filePath, const PPMImage& image, int nuevoMaximo);
+bool escribirNivelMaximo(const std::string& filePath, const PPMImageSoA& image, int nuevoMaximo);
+
+#endif // NIVELES_HPP
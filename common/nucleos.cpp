@@ -0,0 +1,179 @@
+// File: common/nucleos.cpp
+#include "nucleos.hpp"
+
+#include "isa.hpp"
+#include "plano.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace {
+  constexpr std::size_t CANALES = 3;
+  constexpr std::size_t BYTES_16BIT = 2;
+  constexpr std::size_t BYTES_32BIT = 4;
+
+  // Cuerpos de los núcleos: se escriben una vez y se integran en cada variante. Los
+  // planos se copian a variables locales para que el compilador sepa que escribir en
+  // ellos no modifica los propios spans y pueda vectorizar.
+
+  [[gnu::always_inline]] inline void intercambiarCuerpo(std::span<uint8_t> datos) {
+    for (std::size_t i = 0; i + 1 < datos.size(); i += 2) {
+      std::swap(datos[i], datos[i + 1]);
+    }
+  }
+
+  [[gnu::always_inline]] inline void copiarIntercambiandoCuerpo(std::span<uint8_t const> origen,
+                                                                std::span<uint8_t> destino) {
+    for (std::size_t i = 0; i + 1 < origen.size(); i += 2) {
+      destino[i] = origen[i + 1];
+      destino[i + 1] = origen[i];
+    }
+  }
+
+  template <std::size_t Bytes>
+  [[gnu::always_inline]] inline void separarCuerpo(std::span<uint8_t const> intercalado, const PlanosRGB& planos) {
+    const std::span<uint8_t> rojo = planos[0];
+    const std::span<uint8_t> verde = planos[1];
+    const std::span<uint8_t> azul = planos[2];
+    const std::size_t pixeles = intercalado.size() / (CANALES * Bytes);
+    for (std::size_t i = 0; i < pixeles; ++i) {
+      const std::size_t pixel = i * CANALES * Bytes;
+      for (std::size_t byte = 0; byte < Bytes; ++byte) {
+        const std::size_t enArchivo = Bytes - 1 - byte;
+        rojo[(i * Bytes) + byte] = intercalado[pixel + enArchivo];
+        verde[(i * Bytes) + byte] = intercalado[pixel + Bytes + enArchivo];
+        azul[(i * Bytes) + byte] = intercalado[pixel + (2 * Bytes) + enArchivo];
+      }
+    }
+  }
+
+  template <std::size_t Bytes>
+  [[gnu::always_inline]] inline void intercalarCuerpo(const PlanosRGBConst& planos, std::span<uint8_t> intercalado) {
+    const std::span<uint8_t const> rojo = planos[0];
+    const std::span<uint8_t const> verde = planos[1];
+    const std::span<uint8_t const> azul = planos[2];
+    const std::size_t pixeles = intercalado.size() / (CANALES * Bytes);
+    for (std::size_t i = 0; i < pixeles; ++i) {
+      const std::size_t pixel = i * CANALES * Bytes;
+      for (std::size_t byte = 0; byte < Bytes; ++byte) {
+        const std::size_t enArchivo = Bytes - 1 - byte;
+        intercalado[pixel + enArchivo] = rojo[(i * Bytes) + byte];
+        intercalado[pixel + Bytes + enArchivo] = verde[(i * Bytes) + byte];
+        intercalado[pixel + (2 * Bytes) + enArchivo] = azul[(i * Bytes) + byte];
+      }
+    }
+  }
+
+  template <std::size_t Bytes>
+  [[gnu::always_inline]] inline void estrecharCuerpo(std::span<uint32_t const> indices, std::span<uint8_t> destino) {
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      for (std::size_t byte = 0; byte < Bytes; ++byte) {
+        destino[(i * Bytes) + byte] = static_cast<uint8_t>((indices[i] >> (byte * BITS_POR_BYTE)) & MASCARA_BYTE);
+      }
+    }
+  }
+
+  // Variantes por nivel de cada núcleo
+  using NucleoIntercambiar = void (*)(std::span<uint8_t>);
+  using NucleoCopiar = void (*)(std::span<uint8_t const>, std::span<uint8_t>);
+  using NucleoSeparar = void (*)(std::span<uint8_t const>, const PlanosRGB&);
+  using NucleoIntercalar = void (*)(const PlanosRGBConst&, std::span<uint8_t>);
+  using NucleoEstrechar = void (*)(std::span<uint32_t const>, std::span<uint8_t>);
+
+  void intercambiarBase(std::span<uint8_t> datos) { intercambiarCuerpo(datos); }
+  IMTOOL_DESTINO_AVX2 void intercambiarAvx2(std::span<uint8_t> datos) { intercambiarCuerpo(datos); }
+  IMTOOL_DESTINO_AVX512 void intercambiarAvx512(std::span<uint8_t> datos) { intercambiarCuerpo(datos); }
+
+  void copiarBase(std::span<uint8_t const> origen, std::span<uint8_t> destino) {
+    copiarIntercambiandoCuerpo(origen, destino);
+  }
+  IMTOOL_DESTINO_AVX2 void copiarAvx2(std::span<uint8_t const> origen, std::span<uint8_t> destino) {
+    copiarIntercambiandoCuerpo(origen, destino);
+  }
+  IMTOOL_DESTINO_AVX512 void copiarAvx512(std::span<uint8_t const> origen, std::span<uint8_t> destino) {
+    copiarIntercambiandoCuerpo(origen, destino);
+  }
+
+  template <std::size_t Bytes>
+  void separarBase(std::span<uint8_t const> intercalado, const PlanosRGB& planos) {
+    separarCuerpo<Bytes>(intercalado, planos);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX2 void separarAvx2(std::span<uint8_t const> intercalado, const PlanosRGB& planos) {
+    separarCuerpo<Bytes>(intercalado, planos);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX512 void separarAvx512(std::span<uint8_t const> intercalado, const PlanosRGB& planos) {
+    separarCuerpo<Bytes>(intercalado, planos);
+  }
+
+  template <std::size_t Bytes>
+  void intercalarBase(const PlanosRGBConst& planos, std::span<uint8_t> intercalado) {
+    intercalarCuerpo<Bytes>(planos, intercalado);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX2 void intercalarAvx2(const PlanosRGBConst& planos, std::span<uint8_t> intercalado) {
+    intercalarCuerpo<Bytes>(planos, intercalado);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX512 void intercalarAvx512(const PlanosRGBConst& planos, std::span<uint8_t> intercalado) {
+    intercalarCuerpo<Bytes>(planos, intercalado);
+  }
+
+  template <std::size_t Bytes>
+  void estrecharBase(std::span<uint32_t const> indices, std::span<uint8_t> destino) {
+    estrecharCuerpo<Bytes>(indices, destino);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX2 void estrecharAvx2(std::span<uint32_t const> indices, std::span<uint8_t> destino) {
+    estrecharCuerpo<Bytes>(indices, destino);
+  }
+  template <std::size_t Bytes>
+  IMTOOL_DESTINO_AVX512 void estrecharAvx512(std::span<uint32_t const> indices, std::span<uint8_t> destino) {
+    estrecharCuerpo<Bytes>(indices, destino);
+  }
+
+  constexpr VariantesISA<NucleoIntercambiar> INTERCAMBIAR{
+      .base = &intercambiarBase, .avx2 = &intercambiarAvx2, .avx512 = &intercambiarAvx512};
+  constexpr VariantesISA<NucleoCopiar> COPIAR{.base = &copiarBase, .avx2 = &copiarAvx2, .avx512 = &copiarAvx512};
+
+  template <std::size_t Bytes>
+  constexpr VariantesISA<NucleoSeparar> SEPARAR{
+      .base = &separarBase<Bytes>, .avx2 = &separarAvx2<Bytes>, .avx512 = &separarAvx512<Bytes>};
+  template <std::size_t Bytes>
+  constexpr VariantesISA<NucleoIntercalar> INTERCALAR{
+      .base = &intercalarBase<Bytes>, .avx2 = &intercalarAvx2<Bytes>, .avx512 = &intercalarAvx512<Bytes>};
+  template <std::size_t Bytes>
+  constexpr VariantesISA<NucleoEstrechar> ESTRECHAR{
+      .base = &estrecharBase<Bytes>, .avx2 = &estrecharAvx2<Bytes>, .avx512 = &estrecharAvx512<Bytes>};
+}  // namespace
+
+void intercambiarBytes16(std::span<uint8_t> datos) {
+  elegirVariante(INTERCAMBIAR)(datos);
+}
+
+void copiarIntercambiando16(std::span<uint8_t const> origen, std::span<uint8_t> destino) {
+  elegirVariante(COPIAR)(origen, destino);
+}
+
+void separarCanales(std::span<uint8_t const> intercalado, const PlanosRGB& planos, std::size_t bytesPorComponente) {
+  const auto nucleo = (bytesPorComponente == BYTES_16BIT) ? elegirVariante(SEPARAR<BYTES_16BIT>)
+                                                          : elegirVariante(SEPARAR<1>);
+  nucleo(intercalado, planos);
+}
+
+void intercalarCanales(const PlanosRGBConst& planos, std::span<uint8_t> intercalado, std::size_t bytesPorComponente) {
+  const auto nucleo = (bytesPorComponente == BYTES_16BIT) ? elegirVariante(INTERCALAR<BYTES_16BIT>)
+                                                          : elegirVariante(INTERCALAR<1>);
+  nucleo(planos, intercalado);
+}
+
+void estrecharIndices(std::span<uint32_t const> indices, std::span<uint8_t> destino, std::size_t bytes) {
+  switch (bytes) {
+    case 1: elegirVariante(ESTRECHAR<1>)(indices, destino); break;
+    case BYTES_16BIT: elegirVariante(ESTRECHAR<BYTES_16BIT>)(indices, destino); break;
+    default: elegirVariante(ESTRECHAR<BYTES_32BIT>)(indices, destino); break;
+  }
+}
@@ -0,0 +1,53 @@
+// File: common/nucleos.hpp
+#ifndef NUCLEOS_HPP
+#define NUCLEOS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Núcleos de conversión de bytes comunes a la lectura, la escritura y las
+ * operaciones, compilados para cada NivelISA y elegidos al llamarlos (isa.hpp).
+ *
+ * En el archivo los componentes de 16 bits van con el byte alto primero y en memoria
+ * en el orden nativo (el byte bajo primero): estos núcleos hacen la conversión sobre los
+ * bytes del almacenamiento uint16_t de las imágenes (bytesDe).
+ */
+
+/**
+ * @brief Los tres planos R, G y B de una imagen SOA (o de una franja de ella).
+ */
+using PlanosRGB = std::array<std::span<uint8_t>, 3>;
+using PlanosRGBConst = std::array<std::span<uint8_t const>, 3>;
+
+/**
+ * @brief Intercambia los dos bytes de cada componente de 16 bits, en el sitio.
+ */
+void intercambiarBytes16(std::span<uint8_t> datos);
+
+/**
+ * @brief Copia componentes de 16 bits intercambiando sus bytes; destino mide lo mismo
+ * que origen.
+ */
+void copiarIntercambiando16(std::span<uint8_t const> origen, std::span<uint8_t> destino);
+
+/**
+ * @brief Reparte píxeles RGB intercalados, en orden del archivo, en tres planos en
+ * orden de memoria. Cada plano mide intercalado.size() / 3 bytes.
+ */
+void separarCanales(std::span<uint8_t const> intercalado, const PlanosRGB& planos, std::size_t bytesPorComponente);
+
+/**
+ * @brief Operación inversa de separarCanales.
+ */
+void intercalarCanales(const PlanosRGBConst& planos, std::span<uint8_t> intercalado, std::size_t bytesPorComponente);
+
+/**
+ * @brief Estrecha cada índice a sus `bytes` bytes bajos (1, 2 o 4), con el byte bajo
+ * primero. destino mide indices.size() * bytes.
+ */
+void estrecharIndices(std::span<uint32_t const> indices, std::span<uint8_t> destino, std::size_t bytes);
+
+#endif // NUCLEOS_HPP
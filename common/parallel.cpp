@@ -0,0 +1,283 @@
+// File: common/parallel.cpp
+#include "parallel.hpp"
+
+#include "traza.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+  // Por debajo de este número de componentes no compensa repartir el trabajo
+  constexpr std::size_t MIN_WORK_PER_STRIPE = 1U << 16U;
+  // Bloques por hilo de parallelFor con grano automático, para que robar equilibre la carga
+  constexpr std::size_t CHUNKS_PER_THREAD = 4;
+  // Índice de cola de los hilos que no pertenecen al grupo (comparten la cola 0)
+  constexpr std::size_t EXTERNAL_QUEUE = 0;
+  constexpr std::size_t NO_WORKER = std::numeric_limits<std::size_t>::max();
+
+  std::size_t requestedThreads = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  bool pinRequested = false;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  thread_local std::size_t workerIndex = NO_WORKER;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  // Valor entero positivo de una variable de entorno (0 si no existe o no es válido)
+  std::size_t positiveEnv(const char * name) {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe): solo se lee al crear el grupo de hilos
+    if (const char * env = std::getenv(name); env != nullptr) {
+      try {
+        const int value = std::stoi(env);
+        if (value > 0) { return static_cast<std::size_t>(value); }
+      } catch (const std::exception &) {
+        // Valor no numérico: se ignora
+      }
+    }
+    return 0;
+  }
+
+  std::size_t defaultThreadCount() {
+    if (requestedThreads > 0) {
+      return requestedThreads;
+    }
+    if (const std::size_t fromEnv = positiveEnv("IMTOOL_THREADS"); fromEnv > 0) {
+      return fromEnv;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  void pinCurrentThread(std::size_t core) {
+#ifdef __linux__
+    const std::size_t cores = std::max(1U, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+  }
+
+  // Cola de un hilo: su dueño añade y saca por el final (la tarea más reciente, con sus
+  // datos aún en caché) y los demás roban por el principio las tareas más antiguas
+  class WorkQueue {
+    public:
+      void push(std::function<void()> task) {
+        std::lock_guard const lock{mutex};
+        tasks.push_back(std::move(task));
+      }
+
+      bool popBack(std::function<void()> & task) {
+        std::lock_guard const lock{mutex};
+        if (tasks.empty()) { return false; }
+        task = std::move(tasks.back());
+        tasks.pop_back();
+        return true;
+      }
+
+      bool popFront(std::function<void()> & task) {
+        std::lock_guard const lock{mutex};
+        if (tasks.empty()) { return false; }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+      }
+
+    private:
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+  };
+
+  // Grupo de hilos persistente con una cola por hilo y robo de tareas
+  class ThreadPool {
+    public:
+      ThreadPool(std::size_t threads, bool pin) : size(threads), queues(threads) {
+        workers.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i) {
+          workers.emplace_back([this, i, pin](std::stop_token const & stop) { run(i, pin, stop); });
+        }
+      }
+
+      ThreadPool(ThreadPool const &) = delete;
+      ThreadPool(ThreadPool &&) = delete;
+      ThreadPool & operator=(ThreadPool const &) = delete;
+      ThreadPool & operator=(ThreadPool &&) = delete;
+
+      ~ThreadPool() {
+        for (auto & worker : workers) { worker.request_stop(); }
+        wakeAll();
+      }
+
+      [[nodiscard]] std::size_t threads() const { return size; }
+
+      void submit(std::function<void()> task) {
+        {
+          std::lock_guard const lock{sleepMutex};
+          ++queued;
+        }
+        queues[(workerIndex == NO_WORKER) ? EXTERNAL_QUEUE : workerIndex].push(std::move(task));
+        wake.notify_all();
+      }
+
+      // Ejecuta tareas pendientes hasta que done() se cumple; duerme solo si no hay ninguna
+      template <typename Predicate>
+      void helpUntil(Predicate done) {
+        while (!done()) {
+          if (runPending()) { continue; }
+          std::unique_lock lock{sleepMutex};
+          wake.wait(lock, [this, &done] { return done() || queued.load() > 0; });
+        }
+      }
+
+      void wakeAll() {
+        { std::lock_guard const lock{sleepMutex}; }
+        wake.notify_all();
+      }
+
+    private:
+      // Toma una tarea de la cola propia o, si está vacía, la roba de otra
+      bool runPending() {
+        const std::size_t own = (workerIndex == NO_WORKER) ? EXTERNAL_QUEUE : workerIndex;
+        std::function<void()> task;
+        bool found = queues[own].popBack(task);
+        for (std::size_t i = 1; !found && i < size; ++i) {
+          found = queues[(own + i) % size].popFront(task);
+        }
+        if (!found) { return false; }
+        --queued;
+        task();
+        return true;
+      }
+
+      void run(std::size_t index, bool pin, std::stop_token const & stop) {
+        workerIndex = index;
+        nombrarHiloTraza("worker " + std::to_string(index));
+        if (pin) { pinCurrentThread(index); }
+        helpUntil([&stop] { return stop.stop_requested(); });
+      }
+
+      std::size_t size;
+      std::vector<WorkQueue> queues;
+      std::atomic<std::size_t> queued{0};
+      std::mutex sleepMutex;
+      std::condition_variable wake;
+      std::vector<std::jthread> workers;
+  };
+
+  ThreadPool & sharedPool() {
+    static ThreadPool pool{defaultThreadCount(), pinRequested || positiveEnv("IMTOOL_PIN_THREADS") == 1};
+    return pool;
+  }
+
+  std::size_t stripeCount(std::size_t rows, std::size_t rowWork) {
+    const std::size_t totalWork = rows * std::max<std::size_t>(rowWork, 1);
+    const std::size_t byWork = std::max<std::size_t>(totalWork / MIN_WORK_PER_STRIPE, 1);
+    if (byWork <= 1) {
+      return 1;
+    }
+    return std::min({sharedPool().threads(), byWork, rows});
+  }
+
+  // Procesa un bloque de parallelFor; en la traza aparece con su rango de índices
+  void runChunk(IndexRangeFunction const & body, std::size_t first, std::size_t last) {
+    const EventoTraza evento{"chunk", first, last};
+    body(first, last);
+  }
+}  // namespace
+
+void setThreadCount(std::size_t threads) {
+  requestedThreads = threads;
+}
+
+void setThreadPinning(bool pin) {
+  pinRequested = pin;
+}
+
+std::size_t threadCount() {
+  return sharedPool().threads();
+}
+
+TaskGroup::~TaskGroup() {
+  waitAll();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+  pending.fetch_add(1);
+  sharedPool().submit([this, task = std::move(task)] {
+    try {
+      const EventoTraza evento{"task"};
+      task();
+    } catch (...) {
+      std::lock_guard const lock{errorMutex};
+      if (!error) { error = std::current_exception(); }
+    }
+    // Tras el último decremento el grupo puede destruirse: solo se toca el grupo de hilos
+    if (pending.fetch_sub(1) == 1) {
+      sharedPool().wakeAll();
+    }
+  });
+}
+
+void TaskGroup::wait() {
+  waitAll();
+  if (error) {
+    std::rethrow_exception(std::exchange(error, nullptr));
+  }
+}
+
+void TaskGroup::waitAll() {
+  sharedPool().helpUntil([this] { return pending.load() == 0; });
+}
+
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, IndexRangeFunction const & body) {
+  if (begin >= end) {
+    return;
+  }
+  const std::size_t count = end - begin;
+  const std::size_t threads = threadCount();
+  std::size_t step = grain;
+  if (step == 0) {
+    step = (threads == 1) ? count : std::max<std::size_t>(count / (threads * CHUNKS_PER_THREAD), 1);
+  }
+  if (step >= count || threads == 1) {
+    // Sin otros hilos los bloques se procesan en orden en el hilo que llama
+    for (std::size_t first = begin; first < end; first += std::min(step, end - first)) {
+      runChunk(body, first, first + std::min(step, end - first));
+    }
+    return;
+  }
+
+  TaskGroup group;
+  for (std::size_t first = begin + step; first < end;) {
+    const std::size_t last = first + std::min(step, end - first);
+    group.run([&body, first, last] { runChunk(body, first, last); });
+    first = last;
+  }
+  // El hilo que llama procesa el primer bloque y ayuda con el resto mientras espera
+  runChunk(body, begin, begin + step);
+  group.wait();
+}
+
+void parallelForRows(std::size_t rows, std::size_t rowWork, RowStripeFunction const & body) {
+  if (rows == 0) {
+    return;
+  }
+  const std::size_t stripes = stripeCount(rows, rowWork);
+  parallelFor(0, rows, (rows + stripes - 1) / stripes, body);
+}
@@ -0,0 +1,99 @@
+// File: common/parallel.hpp
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Función que procesa el rango de índices [begin, end).
+ */
+using IndexRangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+/**
+ * @brief Función que procesa el rango de filas [rowBegin, rowEnd) de una imagen.
+ */
+using RowStripeFunction = IndexRangeFunction;
+
+/**
+ * @brief Fija el número de hilos del grupo compartido (0 = automático).
+ *
+ * Por defecto se usa la variable de entorno IMTOOL_THREADS o, si no existe, el número
+ * de núcleos. Debe llamarse antes de la primera operación paralela; después no tiene efecto.
+ */
+void setThreadCount(std::size_t threads);
+
+/**
+ * @brief Fija cada hilo del grupo a un núcleo (solo Linux; en otros sistemas se ignora).
+ *
+ * Por defecto los hilos no se fijan salvo que IMTOOL_PIN_THREADS valga 1. Como
+ * setThreadCount, debe llamarse antes de la primera operación paralela.
+ */
+void setThreadPinning(bool pin);
+
+/**
+ * @brief Número de hilos (incluido el que llama) que usan las operaciones paralelas.
+ */
+[[nodiscard]] std::size_t threadCount();
+
+/**
+ * @brief Grupo de tareas que se ejecutan en el grupo de hilos compartido.
+ *
+ * Cada hilo tiene su propia cola: las tareas que crea se añaden a ella y los hilos sin
+ * trabajo las roban de las colas de los demás. wait() no bloquea un hilo mientras haya
+ * tareas pendientes, sino que las ejecuta, de modo que los grupos pueden anidarse
+ * (una tarea puede crear y esperar su propio grupo) sin agotar el grupo de hilos.
+ */
+class TaskGroup {
+  public:
+    TaskGroup() = default;
+    TaskGroup(TaskGroup const &) = delete;
+    TaskGroup(TaskGroup &&) = delete;
+    TaskGroup & operator=(TaskGroup const &) = delete;
+    TaskGroup & operator=(TaskGroup &&) = delete;
+    // Espera a las tareas pendientes; sus excepciones se descartan si no se llamó a wait()
+    ~TaskGroup();
+
+    void run(std::function<void()> task);
+
+    /**
+     * @brief Espera a que terminen todas las tareas del grupo.
+     * @throws La primera excepción lanzada por una de ellas.
+     */
+    void wait();
+
+  private:
+    void waitAll();
+
+    std::atomic<std::size_t> pending{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+/**
+ * @brief Procesa el rango [begin, end) en bloques de `grain` índices repartidos entre los
+ * hilos del grupo compartido; el hilo que llama procesa el primero.
+ *
+ * @param grain Índices por bloque; 0 elige un tamaño que da varios bloques por hilo
+ * @throws La primera excepción lanzada por `body`, cuando han terminado todos los bloques.
+ */
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const IndexRangeFunction& body);
+
+/**
+ * @brief Reparte las filas de una imagen en franjas contiguas y las procesa en paralelo.
+ *
+ * Las franjas se ejecutan en el grupo de hilos compartido por todas las operaciones,
+ * creado una sola vez; el hilo que llama procesa también una franja. Cada hilo recibe
+ * filas consecutivas, de modo que recorre memoria contigua. Las imágenes pequeñas se
+ * procesan en el hilo que llama para no pagar el coste de sincronización.
+ *
+ * @param rows Número total de filas
+ * @param rowWork Número aproximado de componentes por fila (para decidir si compensa paralelizar)
+ * @param body Función que procesa una franja de filas
+ */
+void parallelForRows(std::size_t rows, std::size_t rowWork, const RowStripeFunction& body);
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,103 @@
+// File: common/plano.hpp
+#ifndef PLANO_HPP
+#define PLANO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+/**
+ * @brief Plano de origen de un escalado: filas de width píxeles con `canales`
+ * componentes intercalados cada uno (3 para AOS, 1 para un canal SOA).
+ *
+ * Los componentes ocupan 1 o 2 bytes; los de 2 bytes están en el orden nativo, como
+ * los guardan las imágenes (bytesDe de su almacenamiento de 16 bits). Si filasBuffer no
+ * es 0, datos es una ventana circular de filasBuffer filas y la fila f ocupa la posición
+ * f % filasBuffer. Si bytesPaso no es 0, las filas empiezan cada bytesPaso bytes (planos
+ * con relleno, planos.hpp); si no, van seguidas.
+ */
+struct PlanoOrigen {
+  std::span<uint8_t const> datos;
+  std::size_t width;
+  std::size_t height;
+  std::size_t canales;
+  std::size_t bytesPorComponente;
+  std::size_t filasBuffer = 0;
+  std::size_t bytesPaso = 0;
+};
+
+/**
+ * @brief Plano de destino de un escalado, con el mismo número de canales y de bytes por
+ * componente que el origen.
+ *
+ * datos puede contener solo una franja de filas a partir de primeraFila. bytesPaso es
+ * como en PlanoOrigen.
+ */
+struct PlanoDestino {
+  std::span<uint8_t> datos;
+  std::size_t width;
+  std::size_t height;
+  std::size_t primeraFila = 0;
+  std::size_t bytesPaso = 0;
+};
+
+/**
+ * @brief Rango de filas [inicio, fin) de un plano de destino.
+ */
+struct RangoFilas {
+  std::size_t inicio;
+  std::size_t fin;
+};
+
+constexpr unsigned int BITS_POR_BYTE = 8;
+constexpr uint32_t MASCARA_BYTE = 0xFFU;
+
+/**
+ * @brief Bytes de la fila `fila` de un plano de origen.
+ */
+inline std::span<uint8_t const> filaOrigen(PlanoOrigen const & plano, std::size_t fila) {
+  const std::size_t bytesFila = plano.width * plano.canales * plano.bytesPorComponente;
+  const std::size_t posicion = (plano.filasBuffer == 0) ? fila : fila % plano.filasBuffer;
+  const std::size_t paso = (plano.bytesPaso == 0) ? bytesFila : plano.bytesPaso;
+  return plano.datos.subspan(posicion * paso, bytesFila);
+}
+
+/**
+ * @brief Bytes de la fila `fila` de un plano de destino con `bytesFila` bytes por fila.
+ */
+inline std::span<uint8_t> filaDestino(PlanoDestino const & plano, std::size_t fila, std::size_t bytesFila) {
+  const std::size_t paso = (plano.bytesPaso == 0) ? bytesFila : plano.bytesPaso;
+  return plano.datos.subspan((fila - plano.primeraFila) * paso, bytesFila);
+}
+
+/**
+ * @brief Lee el componente `indice` de una fila de componentes de tipo T (uint8_t o
+ * uint16_t, en el orden nativo). La copia se compila como una sola carga.
+ */
+template <typename T>
+uint32_t leerComponente(std::span<uint8_t const> datos, std::size_t indice) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return datos[indice];
+  } else {
+    T valor{};
+    std::memcpy(&valor, &datos[indice * sizeof(T)], sizeof(T));
+    return valor;
+  }
+}
+
+/**
+ * @brief Escribe el componente `indice` de una fila de componentes de tipo T.
+ */
+template <typename T>
+void escribirComponente(std::span<uint8_t> datos, std::size_t indice, uint32_t valor) {
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    datos[indice] = static_cast<uint8_t>(valor);
+  } else {
+    const auto componente = static_cast<T>(valor);
+    std::memcpy(&datos[indice * sizeof(T)], &componente, sizeof(T));
+  }
+}
+
+#endif // PLANO_HPP
@@ -0,0 +1,66 @@
+// File: common/planos.cpp
+#include "planos.hpp"
+
+#include "reserva.hpp"
+
+#include <cstring>
+#include <utility>
+
+static_assert(ALINEACION_PLANOS <= ALINEACION_RESERVA, "La reserva debe respetar la alineación de los planos");
+
+namespace {
+  // Tamaño de página: los pasos múltiplos de él hacen que todas las filas (o todos los
+  // planos) caigan en los mismos conjuntos de la caché
+  constexpr std::size_t PASO_CONFLICTIVO = 4096;
+
+  std::size_t redondearAlineacion(std::size_t bytes) {
+    return (bytes + ALINEACION_PLANOS - 1) / ALINEACION_PLANOS * ALINEACION_PLANOS;
+  }
+
+  // Redondea a la alineación y aparta una línea de caché los pasos conflictivos
+  std::size_t pasoSinConflictos(std::size_t bytes) {
+    const std::size_t paso = redondearAlineacion(bytes);
+    if (paso > 0 && paso % PASO_CONFLICTIVO == 0) {
+      return paso + ALINEACION_PLANOS;
+    }
+    return paso;
+  }
+}  // namespace
+
+BloqueAlineado::BloqueAlineado(std::size_t bytes) : tamano{bytes} {
+  if (bytes == 0) {
+    return;
+  }
+  // Los planos grandes se reciclan entre imágenes (reserva.hpp)
+  inicio = static_cast<std::byte*>(recursoReserva()->allocate(bytes, ALINEACION_PLANOS));
+  std::memset(inicio, 0, bytes);
+}
+
+BloqueAlineado::BloqueAlineado(BloqueAlineado&& otro) noexcept
+    : inicio{std::exchange(otro.inicio, nullptr)}, tamano{std::exchange(otro.tamano, 0)} {}
+
+BloqueAlineado& BloqueAlineado::operator=(BloqueAlineado&& otro) noexcept {
+  if (this != &otro) {
+    liberar();
+    inicio = std::exchange(otro.inicio, nullptr);
+    tamano = std::exchange(otro.tamano, 0);
+  }
+  return *this;
+}
+
+BloqueAlineado::~BloqueAlineado() {
+  liberar();
+}
+
+void BloqueAlineado::liberar() noexcept {
+  if (inicio != nullptr) {
+    recursoReserva()->deallocate(inicio, tamano, ALINEACION_PLANOS);
+    inicio = nullptr;
+    tamano = 0;
+  }
+}
+
+GeometriaPlanos calcularGeometriaPlanos(std::size_t bytesContenido, std::size_t filas) {
+  const std::size_t bytesFila = pasoSinConflictos(bytesContenido);
+  return {.bytesFila = bytesFila, .bytesPlano = pasoSinConflictos(bytesFila * filas)};
+}
@@ -0,0 +1,178 @@
+// File: common/planos.hpp
+#ifndef PLANOS_HPP
+#define PLANOS_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Alineación de las reservas de planos: una línea de caché, y el ancho de un
+ * registro AVX-512.
+ */
+constexpr std::size_t ALINEACION_PLANOS = 64;
+
+/**
+ * @brief Bloque de memoria alineado a ALINEACION_PLANOS bytes e inicializado a cero,
+ * con propiedad única.
+ */
+class BloqueAlineado {
+  public:
+  BloqueAlineado() = default;
+  explicit BloqueAlineado(std::size_t bytes);
+  BloqueAlineado(const BloqueAlineado&) = delete;
+  BloqueAlineado& operator=(const BloqueAlineado&) = delete;
+  BloqueAlineado(BloqueAlineado&& otro) noexcept;
+  BloqueAlineado& operator=(BloqueAlineado&& otro) noexcept;
+  ~BloqueAlineado();
+
+  [[nodiscard]] std::byte* datos() const { return inicio; }
+  [[nodiscard]] std::size_t bytes() const { return tamano; }
+
+  private:
+  void liberar() noexcept;
+
+  std::byte* inicio = nullptr;
+  std::size_t tamano = 0;
+};
+
+/**
+ * @brief Bytes entre el inicio de dos filas consecutivas y entre el de dos planos
+ * consecutivos.
+ */
+struct GeometriaPlanos {
+  std::size_t bytesFila;
+  std::size_t bytesPlano;
+};
+
+/**
+ * @brief Geometría de tres planos de `filas` filas de `bytesContenido` bytes útiles.
+ *
+ * Cada fila y cada plano empiezan en un múltiplo de ALINEACION_PLANOS. Si el paso
+ * resultante es múltiplo de 4 KiB (anchos potencia de 2), se le suma una línea de caché
+ * más para que las filas vecinas, o el mismo píxel de los tres planos, no caigan en el
+ * mismo conjunto de la caché.
+ */
+GeometriaPlanos calcularGeometriaPlanos(std::size_t bytesContenido, std::size_t filas);
+
+/**
+ * @brief Los tres planos (R, G y B) de una imagen SOA con componentes de tipo T
+ * (uint8_t o uint16_t), en una sola reserva alineada y con las filas rellenadas hasta
+ * paso() componentes. El relleno vale cero y no forma parte de la imagen.
+ */
+template <typename T>
+class PlanosAlineados {
+  public:
+  static constexpr std::size_t CANALES = 3;
+
+  PlanosAlineados() = default;
+
+  PlanosAlineados(std::size_t ancho, std::size_t alto)
+      : anchoPlanos{ancho}, altoPlanos{alto}, geometria{calcularGeometriaPlanos(ancho * sizeof(T), alto)},
+        bloque{CANALES * geometria.bytesPlano} {}
+
+  // Planos con el contenido de tres canales compactos (fila tras fila, sin relleno)
+  PlanosAlineados(std::size_t ancho, std::size_t alto, const std::array<std::vector<T>, CANALES>& canales)
+      : PlanosAlineados(ancho, alto) {
+    for (std::size_t canal = 0; canal < CANALES; ++canal) {
+      for (std::size_t y = 0; y < alto; ++y) {
+        std::memcpy(fila(canal, y).data(), &canales.at(canal).at(y * ancho), ancho * sizeof(T));
+      }
+    }
+  }
+
+  PlanosAlineados(const PlanosAlineados& otros)
+      : anchoPlanos{otros.anchoPlanos}, altoPlanos{otros.altoPlanos}, geometria{otros.geometria},
+        bloque{otros.bloque.bytes()} {
+    if (bloque.bytes() > 0) {
+      std::memcpy(bloque.datos(), otros.bloque.datos(), bloque.bytes());
+    }
+  }
+
+  PlanosAlineados& operator=(const PlanosAlineados& otros) {
+    if (this != &otros) {
+      *this = PlanosAlineados(otros);
+    }
+    return *this;
+  }
+
+  PlanosAlineados(PlanosAlineados&&) noexcept = default;
+  PlanosAlineados& operator=(PlanosAlineados&&) noexcept = default;
+  ~PlanosAlineados() = default;
+
+  [[nodiscard]] std::size_t ancho() const { return anchoPlanos; }
+  [[nodiscard]] std::size_t alto() const { return altoPlanos; }
+  [[nodiscard]] std::size_t pixeles() const { return anchoPlanos * altoPlanos; }
+  [[nodiscard]] bool vacio() const { return pixeles() == 0; }
+
+  // Componentes entre el inicio de dos filas consecutivas de un plano
+  [[nodiscard]] std::size_t paso() const { return geometria.bytesFila / sizeof(T); }
+
+  // Plano completo: alto() filas de paso() componentes
+  [[nodiscard]] std::span<T> plano(std::size_t canal) {
+    return {inicioPlano(canal), paso() * altoPlanos};
+  }
+
+  [[nodiscard]] std::span<T const> plano(std::size_t canal) const {
+    return {inicioPlano(canal), paso() * altoPlanos};
+  }
+
+  // Los ancho() componentes de la fila y del canal
+  [[nodiscard]] std::span<T> fila(std::size_t canal, std::size_t y) { return plano(canal).subspan(y * paso(), anchoPlanos); }
+
+  [[nodiscard]] std::span<T const> fila(std::size_t canal, std::size_t y) const {
+    return plano(canal).subspan(y * paso(), anchoPlanos);
+  }
+
+  // Copia compacta (sin relleno) de un canal
+  [[nodiscard]] std::vector<T> canal(std::size_t canal) const {
+    std::vector<T> compacto;
+    compacto.reserve(pixeles());
+    for (std::size_t y = 0; y < altoPlanos; ++y) {
+      const std::span<T const> datos = fila(canal, y);
+      compacto.insert(compacto.end(), datos.begin(), datos.end());
+    }
+    return compacto;
+  }
+
+  private:
+  [[nodiscard]] T* inicioPlano(std::size_t canal) const {
+    return std::bit_cast<T*>(bloque.datos() + (canal * geometria.bytesPlano));
+  }
+
+  std::size_t anchoPlanos = 0;
+  std::size_t altoPlanos = 0;
+  GeometriaPlanos geometria{.bytesFila = 0, .bytesPlano = 0};
+  BloqueAlineado bloque;
+};
+
+/**
+ * @brief Bytes de un búfer de componentes, para leerlo, escribirlo o convertirlo tal cual.
+ */
+template <typename T, typename Asignador>
+std::span<uint8_t> bytesDe(std::vector<T, Asignador>& datos) {
+  return {std::bit_cast<uint8_t*>(datos.data()), datos.size() * sizeof(T)};
+}
+
+template <typename T, typename Asignador>
+std::span<uint8_t const> bytesDe(const std::vector<T, Asignador>& datos) {
+  return {std::bit_cast<uint8_t const*>(datos.data()), datos.size() * sizeof(T)};
+}
+
+template <typename T>
+  requires(!std::is_const_v<T>)
+std::span<uint8_t> bytesDe(std::span<T> datos) {
+  return {std::bit_cast<uint8_t*>(datos.data()), datos.size_bytes()};
+}
+
+template <typename T>
+std::span<uint8_t const> bytesDe(std::span<T const> datos) {
+  return {std::bit_cast<uint8_t const*>(datos.data()), datos.size_bytes()};
+}
+
+#endif // PLANOS_HPP
@@ -1,11 +1,37 @@
 // File: common/progargs.cpp
 #include "progargs.hpp"
+#include "isa.hpp"
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <cstddef>
 #include <gsl/span>
 
+namespace {
+  const std::string THREADS_SHORT = "-j";
+  const std::string THREADS_LONG = "--threads";
+  const std::string THREADS_LONG_VALUE = "--threads=";
+  const std::string PIN_THREADS = "--pin-threads";
+  const std::string STATS = "--stats";
+  const std::string STATS_VALUE = "--stats=";
+  const std::string COUNTERS = "--counters";
+  const std::string TRACE_VALUE = "--trace=";
+  const std::string ISA_VALUE = "--isa=";
+
+  std::size_t parseThreadCount(const std::string& value) {
+    try {
+      std::size_t consumed = 0;
+      const int threads = std::stoi(value, &consumed);
+      if (consumed == value.size() && threads > 0) {
+        return static_cast<std::size_t>(threads);
+      }
+    } catch (const std::exception&) {
+      // Se informa abajo con el mismo mensaje
+    }
+    throw std::invalid_argument("Invalid thread count: " + value);
+  }
+}  // namespace
+
 ProgramArgs::ProgramArgs(int argc, char** argv) {
   parseArguments(argc, argv);
 }
@@ -26,19 +52,87 @@ const std::vector<std::string>& ProgramArgs::getAdditionalParams() const {
   return additionalParams;
 }
 
+std::size_t ProgramArgs::getThreadCount() const {
+  return threadCount;
+}
+
+bool ProgramArgs::getPinThreads() const {
+  return pinThreads;
+}
+
+bool ProgramArgs::getStats() const {
+  return stats;
+}
+
+const std::string& ProgramArgs::getStatsFile() const {
+  return statsFile;
+}
+
+bool ProgramArgs::getCounters() const {
+  return counters;
+}
+
+const std::string& ProgramArgs::getTraceFile() const {
+  return traceFile;
+}
+
+const std::string& ProgramArgs::getIsaLevel() const {
+  return isaLevel;
+}
+
+// Retira las opciones (-j N, -jN, --threads N, --threads=N, --pin-threads, --stats, --stats=FILE,
+// --counters, --trace=FILE, --isa=LEVEL) y devuelve los argumentos posicionales
+std::vector<std::string> ProgramArgs::extractOptions(const std::vector<std::string>& args) {
+  std::vector<std::string> positional;
+  positional.reserve(args.size());
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    const std::string& arg = args[i];
+    if (arg == THREADS_SHORT || arg == THREADS_LONG) {
+      if (i + 1 >= args.size()) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      threadCount = parseThreadCount(args[++i]);
+    } else if (arg == PIN_THREADS) {
+      pinThreads = true;
+    } else if (arg == STATS) {
+      stats = true;
+    } else if (arg.starts_with(STATS_VALUE)) {
+      stats = true;
+      statsFile = arg.substr(STATS_VALUE.size());
+    } else if (arg == COUNTERS) {
+      // Los contadores se publican en el informe de --stats, así que también lo activan
+      stats = true;
+      counters = true;
+    } else if (arg.starts_with(TRACE_VALUE)) {
+      traceFile = arg.substr(TRACE_VALUE.size());
+      if (traceFile.empty()) {
+        throw std::invalid_argument("Missing file for " + TRACE_VALUE);
+      }
+    } else if (arg.starts_with(ISA_VALUE)) {
+      isaLevel = arg.substr(ISA_VALUE.size());
+      // Solo se valida el nombre: si el procesador lo admite lo comprueba forzarNivelISA
+      (void)leerNivelISA(isaLevel);
+    } else if (arg.starts_with(THREADS_LONG_VALUE)) {
+      threadCount = parseThreadCount(arg.substr(THREADS_LONG_VALUE.size()));
+    } else if (arg.starts_with(THREADS_SHORT) && arg.size() > THREADS_SHORT.size()) {
+      threadCount = parseThreadCount(arg.substr(THREADS_SHORT.size()));
+    } else {
+      positional.push_back(arg);
+    }
+  }
+  return positional;
+}
+
 void ProgramArgs::parseArguments(int argc, char** argv) {
-  if (argc < 4) {
+  const gsl::span rawArgs{argv, static_cast<std::size_t>(argc)};
+  const std::vector<std::string> args = extractOptions({rawArgs.begin(), rawArgs.end()});
+  if (args.size() < 4) {
     throw std::invalid_argument("Insufficient arguments provided.");
   }
 
-  const gsl::span args{argv, static_cast<std::size_t>(argc)};
-
   inputFile = args[1];
   outputFile = args[2];
   operation = args[3];
 
-  additionalParams.reserve(static_cast<std::size_t>(argc - 4));
-  for (std::size_t i = 4; i < static_cast<std::size_t>(argc); ++i) {
-    additionalParams.emplace_back(args[i]);
-  }
+  additionalParams.assign(args.begin() + 4, args.end());
 }
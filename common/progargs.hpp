@@ -2,6 +2,7 @@
 #ifndef PROGARGS_HPP
 #define PROGARGS_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -13,14 +14,36 @@ class ProgramArgs {
   [[nodiscard]] const std::string& getOutputFile() const;
   [[nodiscard]] const std::string& getOperation() const;
   [[nodiscard]] const std::vector<std::string>& getAdditionalParams() const;
+  // Número de hilos pedido con -j N o --threads=N (0 si no se indicó)
+  [[nodiscard]] std::size_t getThreadCount() const;
+  // Si se pidió fijar cada hilo a un núcleo con --pin-threads
+  [[nodiscard]] bool getPinThreads() const;
+  // Si se pidió el informe de tiempos por fase con --stats o --stats=FILE
+  [[nodiscard]] bool getStats() const;
+  // Archivo del informe de --stats=FILE (vacío: se escribe en stderr)
+  [[nodiscard]] const std::string& getStatsFile() const;
+  // Si se pidieron contadores hardware por fase con --counters (implica --stats)
+  [[nodiscard]] bool getCounters() const;
+  // Archivo de la traza Chrome de --trace=FILE (vacío si no se pidió)
+  [[nodiscard]] const std::string& getTraceFile() const;
+  // Nivel de instrucciones forzado con --isa=baseline|avx2|avx512 (vacío: el detectado)
+  [[nodiscard]] const std::string& getIsaLevel() const;
 
   private:
   void parseArguments(int argc, char** argv);
+  std::vector<std::string> extractOptions(const std::vector<std::string>& args);
 
   std::string inputFile;
   std::string outputFile;
   std::string operation;
   std::vector<std::string> additionalParams;
+  std::size_t threadCount = 0;
+  bool pinThreads = false;
+  bool stats = false;
+  std::string statsFile;
+  bool counters = false;
+  std::string traceFile;
+  std::string isaLevel;
 };
 
 #endif // PROGARGS_HPP
@@ -0,0 +1,278 @@
+// File: common/reserva.cpp
+#include "reserva.hpp"
+
+#include "memoria.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+  constexpr std::size_t SUBCLASES_POR_OCTAVA = 4;
+  constexpr unsigned int BITS_MIB = 20;
+
+  // Clase de tamaño de una petición: cuatro clases por potencia de 2, así que un búfer
+  // reciclado desperdicia como mucho un 25 %
+  std::size_t claseTamano(std::size_t bytes) {
+    const std::size_t paso = std::bit_floor(bytes) / SUBCLASES_POR_OCTAVA;
+    return (bytes + paso - 1) / paso * paso;
+  }
+
+  bool reciclable(std::size_t bytes, std::size_t alineacion) {
+    return bytes >= UMBRAL_RESERVA && alineacion <= ALINEACION_RESERVA;
+  }
+
+  // Alineación de los búferes de una clase: solo depende del tamaño, así que un búfer
+  // reciclado está alineado igual que uno nuevo aunque cambie la configuración de páginas
+  // grandes
+  std::size_t alineacionClase(std::size_t clase) {
+    return (clase >= BYTES_PAGINA_GRANDE) ? BYTES_PAGINA_GRANDE : ALINEACION_RESERVA;
+  }
+
+  // Valor entero no negativo de una variable de entorno (-1 si no existe o no es válido)
+  int enteroEnv(const char * nombre) {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe): solo se lee al crear la reserva
+    if (const char * env = std::getenv(nombre); env != nullptr) {
+      try {
+        const int valor = std::stoi(env);
+        if (valor >= 0) { return valor; }
+      } catch (const std::exception &) {
+        // Valor no numérico: se ignora
+      }
+    }
+    return -1;
+  }
+
+  // Límite inicial: IMTOOL_POOL_MB MiB si la variable existe y es un número válido
+  std::size_t limiteInicial() {
+    const int megas = enteroEnv("IMTOOL_POOL_MB");
+    return (megas >= 0) ? static_cast<std::size_t>(megas) << BITS_MIB : LIMITE_RESERVA_POR_DEFECTO;
+  }
+
+  bool paginasGrandesIniciales() {
+#ifdef __linux__
+    return enteroEnv("IMTOOL_HUGEPAGES") != 0;
+#else
+    return false;
+#endif
+  }
+
+  // Modo elegido entre corchetes en transparent_hugepage/enabled ("always [madvise] never");
+  // vacío si el núcleo no tiene páginas grandes transparentes
+  std::string modoPaginasGrandesNucleo() {
+#ifdef __linux__
+    std::ifstream archivo("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string linea;
+    std::getline(archivo, linea);
+    const std::size_t inicio = linea.find('[');
+    const std::size_t fin = linea.find(']', inicio);
+    if (inicio != std::string::npos && fin != std::string::npos) {
+      return linea.substr(inicio + 1, fin - inicio - 1);
+    }
+#endif
+    return {};
+  }
+
+  bool modoAdmiteConsejo(const std::string & modo) {
+    return modo == "always" || modo == "madvise";
+  }
+
+  // Pide al núcleo páginas grandes transparentes para el bloque; false si madvise falla
+  // (núcleo sin THP). Con el modo "never" madvise devuelve 0 pero no las concede, así
+  // que eso se comprueba aparte con modoAdmiteConsejo
+  bool aconsejarPaginasGrandes(void * bloque, std::size_t bytes) {
+#ifdef MADV_HUGEPAGE
+    return madvise(bloque, bytes, MADV_HUGEPAGE) == 0;
+#else
+    static_cast<void>(bloque);
+    static_cast<void>(bytes);
+    return false;
+#endif
+  }
+
+  // Memoria del sistema para la reserva sin pasar por operator new: la reserva ya cuenta
+  // cada petición con registrarAsignacion, y así el operator new contado (memoria.cpp) no
+  // cuenta los mismos bytes dos veces
+  void * memoriaSistema(std::size_t bytes, std::size_t alineacion) {
+    const std::size_t minima = std::max(alineacion, alignof(std::max_align_t));
+    const std::size_t redondeados = (std::max<std::size_t>(bytes, 1) + minima - 1) / minima * minima;
+    // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+    void * bloque = std::aligned_alloc(minima, redondeados);
+    if (bloque == nullptr) {
+      throw std::bad_alloc();
+    }
+    return bloque;
+  }
+
+  void liberarSistema(void * bloque) noexcept {
+    std::free(bloque);  // NOLINT(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+  }
+
+  class ReservaBuferes final : public std::pmr::memory_resource {
+    public:
+    void fijarLimite(std::size_t bytes) {
+      const std::lock_guard lock{mutex};
+      limite = bytes;
+      recortar();
+    }
+
+    void vaciar() {
+      const std::lock_guard lock{mutex};
+      const std::size_t anterior = limite;
+      limite = 0;
+      recortar();
+      limite = anterior;
+    }
+
+    void activarPaginasGrandes(bool activar) {
+      const std::lock_guard lock{mutex};
+      paginasGrandes = activar;
+    }
+
+    LecturaReserva leer() {
+      const std::lock_guard lock{mutex};
+      return {.reutilizados = reutilizados,
+              .nuevos = nuevos,
+              .bytesRetenidos = retenidos,
+              .paginasGrandes = paginasGrandes,
+              .modoPaginasGrandes = modoNucleo,
+              .bytesPaginasGrandes = bytesPaginasGrandes,
+              .rechazosPaginasGrandes = rechazosPaginasGrandes};
+    }
+
+    private:
+    // Cada petición cuenta como una reserva de la fase abierta, venga el bloque de la lista
+    // de libres o del sistema: son los bytes que usa la operación
+    void * do_allocate(std::size_t bytes, std::size_t alineacion) override {
+      void * bloque = tomarBloque(bytes, alineacion);
+      registrarAsignacion(bytes);
+      return bloque;
+    }
+
+    void do_deallocate(void * bloque, std::size_t bytes, std::size_t alineacion) override {
+      registrarLiberacion(bytes);
+      devolverBloque(bloque, bytes, alineacion);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource & otro) const noexcept override {
+      return this == &otro;
+    }
+
+    void * tomarBloque(std::size_t bytes, std::size_t alineacion) {
+      if (!reciclable(bytes, alineacion)) {
+        return memoriaSistema(bytes, alineacion);
+      }
+      const std::size_t clase = claseTamano(bytes);
+      {
+        const std::lock_guard lock{mutex};
+        if (auto encontrada = libres.find(clase); encontrada != libres.end() && !encontrada->second.empty()) {
+          void * bloque = encontrada->second.back();
+          encontrada->second.pop_back();
+          retenidos -= clase;
+          ++reutilizados;
+          return bloque;
+        }
+        ++nuevos;
+      }
+      return reservarNuevo(clase);
+    }
+
+    void devolverBloque(void * bloque, std::size_t bytes, std::size_t alineacion) {
+      if (!reciclable(bytes, alineacion)) {
+        liberarSistema(bloque);
+        return;
+      }
+      const std::size_t clase = claseTamano(bytes);
+      {
+        const std::lock_guard lock{mutex};
+        if (retenidos + clase <= limite) {
+          libres[clase].push_back(bloque);
+          retenidos += clase;
+          return;
+        }
+      }
+      liberarSistema(bloque);
+    }
+
+    // Devuelve al sistema búferes libres hasta quedar dentro del límite; con el mutex tomado
+    void recortar() {
+      for (auto & [clase, bloques] : libres) {
+        while (retenidos > limite && !bloques.empty()) {
+          liberarSistema(bloques.back());
+          bloques.pop_back();
+          retenidos -= clase;
+        }
+      }
+    }
+
+    // Búfer nuevo de una clase; los de páginas grandes se marcan si están activas
+    void * reservarNuevo(std::size_t clase) {
+      void * bloque = memoriaSistema(clase, alineacionClase(clase));
+      if (clase < BYTES_PAGINA_GRANDE) {
+        return bloque;
+      }
+      const std::lock_guard lock{mutex};
+      if (paginasGrandes) {
+        if (modoAdmiteConsejo(modoNucleo) && aconsejarPaginasGrandes(bloque, clase)) {
+          bytesPaginasGrandes += clase;
+        } else {
+          ++rechazosPaginasGrandes;
+        }
+      }
+      return bloque;
+    }
+
+    std::mutex mutex;
+    std::unordered_map<std::size_t, std::vector<void *>> libres;
+    std::size_t limite = limiteInicial();
+    std::size_t retenidos = 0;
+    std::uint64_t reutilizados = 0;
+    std::uint64_t nuevos = 0;
+    bool paginasGrandes = paginasGrandesIniciales();
+    const std::string modoNucleo = modoPaginasGrandesNucleo();
+    std::uint64_t bytesPaginasGrandes = 0;
+    std::uint64_t rechazosPaginasGrandes = 0;
+  };
+
+  ReservaBuferes & reserva() {
+    // No se destruye: las imágenes estáticas pueden liberar sus búferes después de main
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    static ReservaBuferes * const instancia = new ReservaBuferes{};
+    return *instancia;
+  }
+}  // namespace
+
+std::pmr::memory_resource * recursoReserva() {
+  return &reserva();
+}
+
+void fijarLimiteReserva(std::size_t bytes) {
+  reserva().fijarLimite(bytes);
+}
+
+void activarPaginasGrandes(bool activar) {
+  reserva().activarPaginasGrandes(activar);
+}
+
+void vaciarReserva() {
+  reserva().vaciar();
+}
+
+LecturaReserva leerReserva() {
+  return reserva().leer();
+}
+
+bool paginasGrandesDisponibles(const LecturaReserva & lectura) {
+  return lectura.paginasGrandes && modoAdmiteConsejo(lectura.modoPaginasGrandes);
+}
@@ -0,0 +1,145 @@
+// File: common/reserva.hpp
+#ifndef RESERVA_HPP
+#define RESERVA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tamaño mínimo de los búferes que se reciclan; los menores se piden y se
+ * devuelven directamente a operator new.
+ */
+constexpr std::size_t UMBRAL_RESERVA = std::size_t{64} << 10U;
+
+/**
+ * @brief Alineación de todos los búferes reciclados (una línea de caché).
+ */
+constexpr std::size_t ALINEACION_RESERVA = 64;
+
+/**
+ * @brief Tamaño de una página grande transparente de Linux (x86-64 y la configuración
+ * habitual de AArch64). Los búferes nuevos de al menos este tamaño se alinean a él.
+ */
+constexpr std::size_t BYTES_PAGINA_GRANDE = std::size_t{2} << 20U;
+
+/**
+ * @brief Máximo de bytes libres que retiene la reserva si no se indica otro con
+ * fijarLimiteReserva o con la variable de entorno IMTOOL_POOL_MB.
+ */
+constexpr std::size_t LIMITE_RESERVA_POR_DEFECTO = std::size_t{512} << 20U;
+
+/**
+ * @brief Reserva de búferes grandes (píxeles AOS, planos SOA, búferes de lectura y
+ * escritura) compartida por todas las operaciones del proceso.
+ *
+ * Los búferes liberados no vuelven al sistema: se guardan por clases de tamaño (cuatro
+ * por cada potencia de 2) y se entregan a la siguiente petición de la misma clase, lo que
+ * evita repetir mmap/munmap y los fallos de página al tocar memoria nueva cuando se
+ * procesan varias imágenes o niveles de tamaños parecidos. Es segura entre hilos y no se
+ * destruye nunca, para que los objetos estáticos puedan liberar en ella al terminar.
+ *
+ * Los búferes nuevos de BYTES_PAGINA_GRANDE o más se alinean a 2 MiB y, si las páginas
+ * grandes están activas, se marcan con madvise(MADV_HUGEPAGE) para que el núcleo los
+ * respalde con páginas grandes transparentes y las tablas y los accesos dispersos no
+ * agoten la TLB. Si el sistema no las admite (núcleo sin THP o con el modo "never"), el
+ * búfer se usa con páginas normales.
+ */
+[[nodiscard]] std::pmr::memory_resource * recursoReserva();
+
+/**
+ * @brief Fija el máximo de bytes libres retenidos (0 desactiva el reciclaje) y devuelve
+ * al sistema lo que sobre.
+ */
+void fijarLimiteReserva(std::size_t bytes);
+
+/**
+ * @brief Activa o desactiva el consejo de páginas grandes para los búferes nuevos. Por
+ * defecto está activo en Linux salvo que IMTOOL_HUGEPAGES valga 0.
+ */
+void activarPaginasGrandes(bool activar);
+
+/**
+ * @brief Devuelve al sistema todos los búferes libres retenidos.
+ */
+void vaciarReserva();
+
+/**
+ * @brief Peticiones de la reserva servidas con un búfer reciclado y con memoria nueva
+ * desde el inicio del proceso y bytes libres retenidos en este momento.
+ *
+ * Sobre páginas grandes: si están activadas, el modo del núcleo ("always", "madvise",
+ * "never"; vacío si no tiene THP), los bytes de búferes nuevos marcados con madvise y las
+ * veces que no se pudieron pedir (modo "never" o madvise rechazado). Marcar un búfer no
+ * garantiza que el núcleo lo respalde con páginas grandes; eso lo indica paginasGrandesKiB
+ * (memoria.hpp).
+ */
+struct LecturaReserva {
+  std::uint64_t reutilizados;
+  std::uint64_t nuevos;
+  std::uint64_t bytesRetenidos;
+  bool paginasGrandes;
+  std::string modoPaginasGrandes;
+  std::uint64_t bytesPaginasGrandes;
+  std::uint64_t rechazosPaginasGrandes;
+};
+
+/**
+ * @brief Si los búferes nuevos pueden obtener páginas grandes: están activadas y el núcleo
+ * las ofrece para memoria marcada ("always" o "madvise").
+ */
+[[nodiscard]] bool paginasGrandesDisponibles(const LecturaReserva & lectura);
+
+[[nodiscard]] LecturaReserva leerReserva();
+
+/**
+ * @brief Asignador sin estado que sirve los contenedores desde la reserva de búferes.
+ *
+ * A diferencia de std::pmr::polymorphic_allocator no guarda el recurso, así que una copia
+ * del contenedor sigue en la reserva (polymorphic_allocator vuelve al recurso por defecto)
+ * y mover entre contenedores nunca obliga a copiar los elementos.
+ */
+template <typename T>
+struct AsignadorReserva {
+  using value_type = T;
+
+  AsignadorReserva() = default;
+
+  // Conversión entre tipos de elemento que exige std::allocator_traits::rebind
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  constexpr AsignadorReserva(const AsignadorReserva<U> & /*otro*/) noexcept {}
+
+  [[nodiscard]] T * allocate(std::size_t n) {
+    return static_cast<T *>(recursoReserva()->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T * bloque, std::size_t n) noexcept {
+    recursoReserva()->deallocate(bloque, n * sizeof(T), alignof(T));
+  }
+
+  // Sin estado: cualquier asignador libera lo que reservó otro
+  friend bool operator==(const AsignadorReserva & /*a*/, const AsignadorReserva & /*b*/) noexcept {
+    return true;
+  }
+};
+
+/**
+ * @brief Vector cuyo almacenamiento sale de la reserva de búferes (búferes de imagen AOS).
+ */
+template <typename T>
+using VectorReserva = std::vector<T, AsignadorReserva<T>>;
+
+/**
+ * @brief Arena para la memoria auxiliar de una operación (histogramas, paletas, tablas
+ * de coeficientes): reserva de forma monótona, sin liberar nada hasta destruirse, en
+ * bloques que salen de la reserva de búferes y vuelven a ella al final.
+ */
+class ArenaTemporal : public std::pmr::monotonic_buffer_resource {
+  public:
+  ArenaTemporal() : std::pmr::monotonic_buffer_resource(UMBRAL_RESERVA, recursoReserva()) {}
+};
+
+#endif // RESERVA_HPP
@@ -0,0 +1,245 @@
+// File: common/sintetico.cpp
+#include "sintetico.hpp"
+
+#include "nucleos.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+  constexpr std::size_t COMPONENTES_POR_PIXEL = 3;
+  constexpr uint32_t MAX_8BIT_VALUE = 255;
+  constexpr uint32_t MAX_16BIT_VALUE = 65535;
+  constexpr unsigned int BITS_BYTE = 8;
+  constexpr std::size_t LADO_REGION = 32;
+
+  // Constantes de splitmix64
+  constexpr uint64_t INCREMENTO_MEZCLA = 0x9E3779B97F4A7C15ULL;
+  constexpr uint64_t MULTIPLICADOR_A = 0xBF58476D1CE4E5B9ULL;
+  constexpr uint64_t MULTIPLICADOR_B = 0x94D049BB133111EBULL;
+  constexpr unsigned int DESPLAZAMIENTO_A = 30;
+  constexpr unsigned int DESPLAZAMIENTO_B = 27;
+  constexpr unsigned int DESPLAZAMIENTO_C = 31;
+  // Un double tiene 53 bits de mantisa: los 11 bits bajos del entero aleatorio sobran
+  constexpr unsigned int BITS_DESCARTADOS = 11;
+  constexpr double ESCALA_UNIDAD = 0x1.0p-53;
+
+  // Finalizador de splitmix64: mezcla todos los bits de la entrada
+  uint64_t mezclar(uint64_t valor) {
+    valor += INCREMENTO_MEZCLA;
+    valor = (valor ^ (valor >> DESPLAZAMIENTO_A)) * MULTIPLICADOR_A;
+    valor = (valor ^ (valor >> DESPLAZAMIENTO_B)) * MULTIPLICADOR_B;
+    return valor ^ (valor >> DESPLAZAMIENTO_C);
+  }
+
+  // Número aleatorio asociado a un componente: depende solo de la semilla y la posición
+  uint64_t aleatorio(uint64_t semilla, uint64_t indice, uint64_t canal) {
+    return mezclar(semilla ^ mezclar((indice * COMPONENTES_POR_PIXEL) + canal));
+  }
+
+  // Número real uniforme en [0, 1)
+  double unidad(uint64_t valor) {
+    return static_cast<double>(valor >> BITS_DESCARTADOS) * ESCALA_UNIDAD;
+  }
+
+  // Valor proporcional a posicion / ultima en [0, maximo]
+  uint32_t proporcional(std::size_t posicion, std::size_t ultima, uint32_t maximo) {
+    if (ultima == 0) {
+      return 0;
+    }
+    return static_cast<uint32_t>((static_cast<uint64_t>(posicion) * maximo) / ultima);
+  }
+
+  void validarOpciones(const OpcionesSintetico& opciones) {
+    const PPMAttributes& attrs = opciones.atributos;
+    if (attrs.width <= 0 || attrs.height <= 0) {
+      throw std::invalid_argument("Invalid image size: " + std::to_string(attrs.width) + "x" +
+                                  std::to_string(attrs.height));
+    }
+    if (attrs.maxValue <= 0 || std::cmp_greater(attrs.maxValue, MAX_16BIT_VALUE)) {
+      throw std::invalid_argument("The max level must be between 1 and " + std::to_string(MAX_16BIT_VALUE));
+    }
+    if (opciones.ruido < 0 || opciones.zipf < 0.0) {
+      throw std::invalid_argument("Noise amplitude and Zipf exponent must not be negative");
+    }
+    if (opciones.patron != PatronSintetico::regiones && opciones.patron != PatronSintetico::paleta) {
+      return;
+    }
+    // Colores distintos que caben con ese valor máximo: (maxValue + 1)^3
+    const auto niveles = static_cast<double>(attrs.maxValue) + 1.0;
+    if (opciones.colores == 0 || static_cast<double>(opciones.colores) > niveles * niveles * niveles) {
+      throw std::invalid_argument("Invalid number of colors: " + std::to_string(opciones.colores));
+    }
+  }
+}  // namespace
+
+PatronSintetico leerPatronSintetico(const std::string& nombre) {
+  if (nombre == "gradient") {
+    return PatronSintetico::degradado;
+  }
+  if (nombre == "noise") {
+    return PatronSintetico::ruido;
+  }
+  if (nombre == "regions") {
+    return PatronSintetico::regiones;
+  }
+  if (nombre == "palette") {
+    return PatronSintetico::paleta;
+  }
+  throw std::invalid_argument("Invalid synthetic pattern: " + nombre);
+}
+
+GeneradorSintetico::GeneradorSintetico(const OpcionesSintetico& opciones) : opciones(opciones) {
+  validarOpciones(opciones);
+  if (opciones.patron == PatronSintetico::regiones || opciones.patron == PatronSintetico::paleta) {
+    crearPaleta();
+  }
+}
+
+const PPMAttributes& GeneradorSintetico::atributos() const {
+  return opciones.atributos;
+}
+
+// Colores distintos sacados de la semilla y su distribución acumulada de Zipf
+void GeneradorSintetico::crearPaleta() {
+  const auto niveles = static_cast<uint64_t>(opciones.atributos.maxValue) + 1;
+  std::unordered_set<uint64_t> usados;
+  usados.reserve(opciones.colores);
+  paleta.reserve(opciones.colores);
+  for (uint64_t intento = 0; paleta.size() < opciones.colores; ++intento) {
+    const Color candidato{.r = static_cast<uint32_t>(aleatorio(opciones.semilla, intento, 0) % niveles),
+                          .g = static_cast<uint32_t>(aleatorio(opciones.semilla, intento, 1) % niveles),
+                          .b = static_cast<uint32_t>(aleatorio(opciones.semilla, intento, 2) % niveles)};
+    if (usados.insert((((candidato.r * niveles) + candidato.g) * niveles) + candidato.b).second) {
+      paleta.push_back(candidato);
+    }
+  }
+
+  acumulada.resize(paleta.size());
+  double suma = 0.0;
+  for (std::size_t k = 0; k < paleta.size(); ++k) {
+    suma += 1.0 / std::pow(static_cast<double>(k + 1), opciones.zipf);
+    acumulada[k] = suma;
+  }
+}
+
+// Color del elemento `indice` de `total` (píxeles o bloques). Los elementos en las
+// posiciones k * total / colores llevan el color k, de modo que todos los colores de la
+// paleta aparecen al menos una vez; el resto sigue la distribución de Zipf.
+GeneradorSintetico::Color GeneradorSintetico::colorPaleta(uint64_t indice, uint64_t total) const {
+  const uint64_t colores = paleta.size();
+  if (colores <= total) {
+    const uint64_t k = ((indice * colores) + total - 1) / total;
+    if (k < colores && (k * total) / colores == indice) {
+      return paleta[k];
+    }
+  }
+  const double objetivo = unidad(aleatorio(opciones.semilla, indice, 0)) * acumulada.back();
+  const auto encontrado = std::ranges::upper_bound(acumulada, objetivo);
+  const auto k = static_cast<std::size_t>(std::distance(acumulada.begin(), encontrado));
+  return paleta[std::min(k, paleta.size() - 1)];
+}
+
+GeneradorSintetico::Color GeneradorSintetico::colorDegradado(std::size_t x, std::size_t y) const {
+  const auto width = static_cast<std::size_t>(opciones.atributos.width);
+  const auto height = static_cast<std::size_t>(opciones.atributos.height);
+  const auto maximo = static_cast<uint32_t>(opciones.atributos.maxValue);
+  const Color base{.r = proporcional(x, width - 1, maximo),
+                   .g = proporcional(y, height - 1, maximo),
+                   .b = proporcional(x + y, width + height - 2, maximo)};
+  if (opciones.ruido == 0) {
+    return base;
+  }
+  // Ruido uniforme en [-ruido, ruido], recortado al rango de la imagen
+  const uint64_t indice = (y * width) + x;
+  const auto amplitud = static_cast<int64_t>(opciones.ruido);
+  const auto sumarRuido = [&](uint32_t valor, uint64_t canal) {
+    const auto desplazamiento = static_cast<int64_t>(
+        aleatorio(opciones.semilla, indice, canal) % static_cast<uint64_t>((2 * amplitud) + 1));
+    return static_cast<uint32_t>(
+        std::clamp<int64_t>(static_cast<int64_t>(valor) + desplazamiento - amplitud, 0, maximo));
+  };
+  return {.r = sumarRuido(base.r, 0), .g = sumarRuido(base.g, 1), .b = sumarRuido(base.b, 2)};
+}
+
+GeneradorSintetico::Color GeneradorSintetico::colorRuido(std::size_t x, std::size_t y) const {
+  const uint64_t indice = (y * static_cast<std::size_t>(opciones.atributos.width)) + x;
+  const auto niveles = static_cast<uint64_t>(opciones.atributos.maxValue) + 1;
+  return {.r = static_cast<uint32_t>(aleatorio(opciones.semilla, indice, 0) % niveles),
+          .g = static_cast<uint32_t>(aleatorio(opciones.semilla, indice, 1) % niveles),
+          .b = static_cast<uint32_t>(aleatorio(opciones.semilla, indice, 2) % niveles)};
+}
+
+GeneradorSintetico::Color GeneradorSintetico::color(std::size_t x, std::size_t y) const {
+  const auto width = static_cast<std::size_t>(opciones.atributos.width);
+  const auto height = static_cast<std::size_t>(opciones.atributos.height);
+  switch (opciones.patron) {
+    case PatronSintetico::degradado:
+      return colorDegradado(x, y);
+    case PatronSintetico::ruido:
+      return colorRuido(x, y);
+    case PatronSintetico::regiones: {
+      const std::size_t bloquesX = (width + LADO_REGION - 1) / LADO_REGION;
+      const std::size_t bloquesY = (height + LADO_REGION - 1) / LADO_REGION;
+      return colorPaleta(((y / LADO_REGION) * bloquesX) + (x / LADO_REGION), bloquesX * bloquesY);
+    }
+    case PatronSintetico::paleta:
+      return colorPaleta((y * width) + x, width * height);
+  }
+  return {.r = 0, .g = 0, .b = 0};
+}
+
+void GeneradorSintetico::generarFilas(std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd) const {
+  const auto width = static_cast<std::size_t>(opciones.atributos.width);
+  const bool dosBytes = std::cmp_greater(opciones.atributos.maxValue, MAX_8BIT_VALUE);
+  const std::size_t bytesPorFila = width * COMPONENTES_POR_PIXEL * (dosBytes ? 2 : 1);
+  parallelForRows(rowEnd - rowBegin, width * COMPONENTES_POR_PIXEL, [&](std::size_t primera, std::size_t ultima) {
+    for (std::size_t fila = primera; fila < ultima; ++fila) {
+      auto salida = destino.subspan(fila * bytesPorFila, bytesPorFila).begin();
+      for (std::size_t x = 0; x < width; ++x) {
+        const Color pixel = color(x, rowBegin + fila);
+        for (const uint32_t componente : {pixel.r, pixel.g, pixel.b}) {
+          if (dosBytes) {
+            *salida++ = static_cast<uint8_t>(componente >> BITS_BYTE);
+          }
+          *salida++ = static_cast<uint8_t>(componente & MAX_8BIT_VALUE);
+        }
+      }
+    }
+  });
+}
+
+PPMImage generarImagenSintetica(const OpcionesSintetico& opciones) {
+  const GeneradorSintetico generador(opciones);
+  PPMImage image(opciones.atributos);
+  const bool dosBytes = std::cmp_greater(image.maxValue, MAX_8BIT_VALUE);
+  const std::size_t componentes =
+      static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) * COMPONENTES_POR_PIXEL;
+  if (!dosBytes) {
+    image.pixelData.resize(componentes);
+    generador.generarFilas(image.pixelData, 0, static_cast<std::size_t>(image.height));
+    return image;
+  }
+  // Las filas se generan en el orden del archivo y se pasan una vez al orden nativo
+  image.pixelData16.resize(componentes);
+  generador.generarFilas(bytesDe(image.pixelData16), 0, static_cast<std::size_t>(image.height));
+  intercambiarBytes16(bytesDe(image.pixelData16));
+  return image;
+}
+
+bool escribirImagenSintetica(const std::string& filePath, const OpcionesSintetico& opciones) {
+  const GeneradorSintetico generador(opciones);
+  return escribirImagenPPMPorFilas(filePath, generador.atributos(),
+                                   [&generador](std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd) {
+                                     generador.generarFilas(destino, rowBegin, rowEnd);
+                                   });
+}
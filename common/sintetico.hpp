@@ -0,0 +1,97 @@
+// File: common/sintetico.hpp
+#ifndef SINTETICO_HPP
+#define SINTETICO_HPP
+
+#include "binario.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Patrón de una imagen sintética.
+ *
+ * - degradado: degradados suaves en cada canal, opcionalmente con ruido acotado.
+ * - ruido: cada componente es independiente y uniforme (casi un color por píxel).
+ * - regiones: bloques planos de LADO_REGION píxeles con colores de la paleta.
+ * - paleta: cada píxel toma un color de la paleta.
+ */
+enum class PatronSintetico { degradado, ruido, regiones, paleta };
+
+/**
+ * @brief Traduce el nombre de un patrón ("gradient", "noise", "regions" o "palette").
+ * @throws std::invalid_argument si el nombre no corresponde a ningún patrón.
+ */
+PatronSintetico leerPatronSintetico(const std::string& nombre);
+
+/**
+ * @brief Parámetros de una imagen sintética.
+ *
+ * En los patrones regiones y paleta, `colores` es el número de colores distintos de la
+ * imagen (exacto si hay al menos tantos bloques o píxeles como colores) y `zipf` el
+ * exponente de su frecuencia: el color k aparece con probabilidad proporcional a
+ * 1/(k+1)^zipf, de modo que 0 da una paleta uniforme y valores mayores concentran la
+ * imagen en pocos colores. `ruido` es la amplitud máxima, en unidades de maxValue, que
+ * se suma a cada componente del degradado.
+ */
+struct OpcionesSintetico {
+  PPMAttributes atributos;
+  PatronSintetico patron;
+  std::size_t colores;
+  double zipf;
+  int ruido;
+  uint64_t semilla;
+};
+
+/**
+ * @brief Genera imágenes sintéticas reproducibles: cada píxel depende solo de la semilla,
+ * del patrón y de su posición, así que las filas pueden generarse en cualquier orden y
+ * con cualquier número de hilos sin cambiar el resultado.
+ */
+class GeneradorSintetico {
+  public:
+  /**
+   * @throws std::invalid_argument si el tamaño, el valor máximo o los colores no son válidos.
+   */
+  explicit GeneradorSintetico(const OpcionesSintetico& opciones);
+
+  [[nodiscard]] const PPMAttributes& atributos() const;
+
+  /**
+   * @brief Escribe las filas [rowBegin, rowEnd) tal y como van en el archivo (16 bits con
+   * el byte alto primero); sirve de ProductorFilas para escribirImagenPPMPorFilas.
+   */
+  void generarFilas(std::span<uint8_t> destino, std::size_t rowBegin, std::size_t rowEnd) const;
+
+  private:
+  struct Color {
+    uint32_t r;
+    uint32_t g;
+    uint32_t b;
+  };
+
+  [[nodiscard]] Color color(std::size_t x, std::size_t y) const;
+  [[nodiscard]] Color colorDegradado(std::size_t x, std::size_t y) const;
+  [[nodiscard]] Color colorRuido(std::size_t x, std::size_t y) const;
+  [[nodiscard]] Color colorPaleta(uint64_t indice, uint64_t total) const;
+  void crearPaleta();
+
+  OpcionesSintetico opciones;
+  std::vector<Color> paleta;
+  std::vector<double> acumulada;  // distribución acumulada de Zipf sobre la paleta
+};
+
+/**
+ * @brief Imagen sintética en memoria, con el formato que deja leerImagenPPM.
+ */
+PPMImage generarImagenSintetica(const OpcionesSintetico& opciones);
+
+/**
+ * @brief Escribe una imagen sintética en un archivo P6 franja a franja, sin tenerla
+ * entera en memoria.
+ */
+bool escribirImagenSintetica(const std::string& filePath, const OpcionesSintetico& opciones);
+
+#endif // SINTETICO_HPP
@@ -0,0 +1,148 @@
+// File: common/traza.cpp
+#include "traza.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+  using Reloj = std::chrono::steady_clock;
+
+  constexpr std::size_t EVENTOS_RESERVADOS = 1024;
+  constexpr int DECIMALES_US = 3;
+  constexpr double NS_POR_US = 1e3;
+
+  struct Evento {
+    std::string_view nombre;
+    Reloj::time_point inicio;
+    Reloj::time_point fin;
+    std::size_t inicioRango;
+    std::size_t finRango;
+    bool conRango;
+  };
+
+  // Eventos de un hilo: solo los añade su hilo, y se leen al escribir la traza
+  struct BufferHilo {
+    std::string nombre;
+    std::vector<Evento> eventos;
+  };
+
+  struct Traza {
+    bool activa = false;
+    std::string archivo;
+    Reloj::time_point inicio;
+    std::mutex mutex;  // protege solo la lista de búferes
+    std::vector<std::unique_ptr<BufferHilo>> buffers;
+  };
+
+  Traza & traza() {
+    static Traza estado;
+    return estado;
+  }
+
+  thread_local BufferHilo * bufferActual = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  thread_local std::string nombreHilo;               // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+  // Búfer del hilo que llama; se crea (y se registra) la primera vez que lo usa
+  BufferHilo & bufferHilo() {
+    if (bufferActual == nullptr) {
+      Traza & estado = traza();
+      auto buffer = std::make_unique<BufferHilo>();
+      buffer->eventos.reserve(EVENTOS_RESERVADOS);
+      const std::lock_guard lock{estado.mutex};
+      buffer->nombre = nombreHilo.empty() ? "thread " + std::to_string(estado.buffers.size()) : nombreHilo;
+      bufferActual = estado.buffers.emplace_back(std::move(buffer)).get();
+    }
+    return *bufferActual;
+  }
+
+  double microsegundos(Reloj::duration duracion) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duracion).count()) / NS_POR_US;
+  }
+
+  void escribirEvento(std::ostream & salida, const Evento & evento, std::size_t hilo, Reloj::time_point origen) {
+    salida << ",\n{\"name\": \"" << evento.nombre << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << hilo
+           << ", \"ts\": " << microsegundos(evento.inicio - origen)
+           << ", \"dur\": " << microsegundos(evento.fin - evento.inicio);
+    if (evento.conRango) {
+      salida << ", \"args\": {\"begin\": " << evento.inicioRango << ", \"end\": " << evento.finRango << "}";
+    }
+    salida << "}";
+  }
+
+  void escribirEventos(std::ostream & salida, Traza & estado) {
+    const std::lock_guard lock{estado.mutex};
+    salida << std::fixed << std::setprecision(DECIMALES_US) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n"
+           << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"imtool\"}}";
+    for (std::size_t hilo = 0; hilo < estado.buffers.size(); ++hilo) {
+      const BufferHilo & buffer = *estado.buffers[hilo];
+      salida << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << hilo
+             << ", \"args\": {\"name\": \"" << buffer.nombre << "\"}}";
+      for (const Evento & evento : buffer.eventos) {
+        escribirEvento(salida, evento, hilo, estado.inicio);
+      }
+    }
+    salida << "\n]}\n";
+  }
+}  // namespace
+
+void activarTraza(const std::string & archivo) {
+  Traza & estado = traza();
+  estado.archivo = archivo;
+  estado.inicio = Reloj::now();
+  estado.activa = true;
+}
+
+bool trazaActiva() {
+  return traza().activa;
+}
+
+void nombrarHiloTraza(const std::string & nombre) {
+  nombreHilo = nombre;
+  if (bufferActual != nullptr) {
+    const std::lock_guard lock{traza().mutex};
+    bufferActual->nombre = nombre;
+  }
+}
+
+EventoTraza::EventoTraza(std::string_view nombre) : nombre(nombre), activo(traza().activa) {
+  if (activo) {
+    inicio = Reloj::now();
+  }
+}
+
+EventoTraza::EventoTraza(std::string_view nombre, std::size_t primero, std::size_t ultimo)
+    : nombre(nombre), inicioRango(primero), finRango(ultimo), conRango(true), activo(traza().activa) {
+  if (activo) {
+    inicio = Reloj::now();
+  }
+}
+
+EventoTraza::~EventoTraza() {
+  if (activo) {
+    bufferHilo().eventos.push_back({.nombre = nombre, .inicio = inicio, .fin = Reloj::now(),
+                                    .inicioRango = inicioRango, .finRango = finRango, .conRango = conRango});
+  }
+}
+
+bool escribirTraza() {
+  Traza & estado = traza();
+  if (!estado.activa) {
+    return true;
+  }
+  std::ofstream archivo(estado.archivo);
+  if (!archivo) {
+    std::cerr << "Error al abrir el archivo de traza: " << estado.archivo << '\n';
+    return false;
+  }
+  escribirEventos(archivo, estado);
+  return archivo.good();
+}
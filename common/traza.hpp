@@ -0,0 +1,64 @@
+// File: common/traza.hpp
+#ifndef TRAZA_HPP
+#define TRAZA_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Activa el registro de eventos (--trace=FILE). Hasta que se llama, cada
+ * EventoTraza solo comprueba un indicador.
+ *
+ * @param archivo Archivo donde escribirTraza dejará la traza
+ */
+void activarTraza(const std::string& archivo);
+
+/**
+ * @brief Si el registro de eventos está activo.
+ */
+[[nodiscard]] bool trazaActiva();
+
+/**
+ * @brief Nombre con el que aparece el hilo que llama en la traza ("main", "worker 3"...).
+ */
+void nombrarHiloTraza(const std::string& nombre);
+
+/**
+ * @brief Registra un evento de la traza desde su construcción hasta su destrucción.
+ *
+ * Cada hilo guarda sus eventos en su propio búfer, sin bloqueos ni sincronización con
+ * los demás. El nombre no se copia: debe seguir existiendo hasta escribirTraza (en la
+ * práctica, un literal). El rango [primero, ultimo), si se indica, aparece como argumento
+ * del evento, por ejemplo las filas de una franja.
+ */
+class EventoTraza {
+  public:
+  explicit EventoTraza(std::string_view nombre);
+  EventoTraza(std::string_view nombre, std::size_t primero, std::size_t ultimo);
+  EventoTraza(const EventoTraza&) = delete;
+  EventoTraza(EventoTraza&&) = delete;
+  EventoTraza& operator=(const EventoTraza&) = delete;
+  EventoTraza& operator=(EventoTraza&&) = delete;
+  ~EventoTraza();
+
+  private:
+  std::string_view nombre;
+  std::size_t inicioRango = 0;
+  std::size_t finRango = 0;
+  bool conRango = false;
+  bool activo;
+  std::chrono::steady_clock::time_point inicio{};
+};
+
+/**
+ * @brief Escribe los eventos de todos los hilos en formato Chrome trace-event (JSON),
+ * que cargan chrome://tracing y Perfetto. Debe llamarse cuando ningún hilo esté
+ * registrando eventos, al terminar la operación. No hace nada si la traza no está activa.
+ *
+ * @return false si no se pudo escribir el archivo.
+ */
+bool escribirTraza();
+
+#endif // TRAZA_HPP
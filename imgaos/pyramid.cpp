@@ -0,0 +1,74 @@
+// File: imgaos/pyramid.cpp
+#include "pyramid.hpp"
+#include "../common/binario.hpp"
+#include "../common/estadisticas.hpp"
+#include "../common/escalado.hpp"
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  constexpr std::size_t COMPONENTES_POR_PIXEL = 3;
+  constexpr int MAX_VALUE_8BIT = 255;
+
+  void validateLevels(int levels) {
+    if (levels < 0) {
+      throw std::invalid_argument("Número de niveles fuera de rango.");
+    }
+  }
+
+  // Reduce la imagen a la mitad en cada eje con la media de cada bloque de 2x2
+  // (el núcleo de área de factor 2 cuando ambos ejes son pares)
+  PPMImage reducirMitad(const PPMImage& imagen) {
+    const bool dosBytes = imagen.maxValue > MAX_VALUE_8BIT;
+    PPMImage reducida(PPMAttributes{.width = tamanoNivelPiramide(imagen.width),
+                                    .height = tamanoNivelPiramide(imagen.height),
+                                    .maxValue = imagen.maxValue});
+    const std::size_t componentes =
+        static_cast<std::size_t>(reducida.width) * static_cast<std::size_t>(reducida.height) * COMPONENTES_POR_PIXEL;
+    if (dosBytes) {
+      reducida.pixelData16.resize(componentes);
+    } else {
+      reducida.pixelData.resize(componentes);
+    }
+
+    const PlanoOrigen origen{.datos = dosBytes ? bytesDe(imagen.pixelData16) : bytesDe(imagen.pixelData),
+                             .width = static_cast<std::size_t>(imagen.width),
+                             .height = static_cast<std::size_t>(imagen.height),
+                             .canales = COMPONENTES_POR_PIXEL,
+                             .bytesPorComponente = dosBytes ? 2U : 1U};
+    const PlanoDestino destino{.datos = dosBytes ? bytesDe(reducida.pixelData16) : bytesDe(reducida.pixelData),
+                               .width = static_cast<std::size_t>(reducida.width),
+                               .height = static_cast<std::size_t>(reducida.height)};
+    escalarPlano(crearPlanEscalado(FiltroEscalado::area, origen, destino), origen, destino);
+    return reducida;
+  }
+}
+
+void performPyramidOperation(const std::string& inputFile, const std::string& outputFile, int levels) {
+  std::cout << "Realizando la operación pyramid en imgaos con " << levels << " niveles\n";
+  std::cout << "Archivo de entrada: " << inputFile << "\n";
+  validateLevels(levels);
+
+  PPMImage nivelActual{};
+  if (!leerImagenPPM(inputFile, nivelActual)) {
+    throw std::runtime_error("Error al leer el archivo de entrada");
+  }
+
+  // Cada nivel se calcula a partir del anterior, no de la imagen original
+  for (int nivel = 1; (levels == 0 || nivel <= levels) && (nivelActual.width > 1 || nivelActual.height > 1);
+       ++nivel) {
+    {
+      const FaseMedida fase{"kernel"};
+      nivelActual = reducirMitad(nivelActual);
+    }
+    const std::string rutaNivel = rutaNivelPiramide(outputFile, nivel);
+    if (!escribirImagenPPM(rutaNivel, nivelActual)) {
+      throw std::runtime_error("Error al escribir el archivo de salida");
+    }
+    std::cout << "Nivel " << nivel << " (" << nivelActual.width << "x" << nivelActual.height << "): " << rutaNivel
+              << "\n";
+  }
+  std::cout << "Operación completada exitosamente.\n";
+}
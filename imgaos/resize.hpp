@@ -5,6 +5,8 @@
 #ifndef RESIZE_HPP
 #define RESIZE_HPP
 
+#include "../common/escalado.hpp"
+
 #include <string>
 
 /**
@@ -13,6 +15,7 @@
  * Esta función realiza un escalado de imágenes utilizando interpolación bilineal,
  * empleando una estructura de tipo Array of Structs (AOS) p
  * ara manejar los píxeles como objetos individuales con componentes RGB.
+ * Admite componentes de 8 y 16 bits y conserva el valor máximo de la imagen de entrada.
  *
  * @param inputFile Ruta del archivo de imagen PPM de entrada
  * @param outputFile Ruta donde se guardará la imagen PPM resultante
@@ -26,5 +29,18 @@ void performResizeOperation(const std::string& inputFile,
                             const std::string& outputFile,
                             int newWidth, int newHeight);
 
+/**
+ * @brief Escala una imagen P6 PPM con el filtro indicado (vecino, bilineal o área).
+ *
+ * @param inputFile Ruta del archivo de imagen PPM de entrada
+ * @param outputFile Ruta donde se guardará la imagen PPM resultante
+ * @param opciones Nuevo tamaño y filtro de escalado
+ * @throws std::invalid_argument si el nuevo tamaño es menor o igual a 0.
+ * @throws std::runtime_error si ocurre un error al leer o escribir los archivos.
+ */
+void performResizeOperation(const std::string& inputFile,
+                            const std::string& outputFile,
+                            const OpcionesEscalado& opciones);
+
 
 #endif //RESIZE_HPP
@@ -0,0 +1,105 @@
+// File: imgen/main.cpp
+// Generador de imágenes P6 sintéticas y reproducibles para pruebas de rendimiento:
+//   imgen <salida.ppm> <ancho> <alto> <gradient|noise|regions|palette>
+//         [--max=N] [--colors=N] [--zipf=S] [--noise=N] [--seed=N] [-j N | --threads=N]
+#include "../common/parallel.hpp"           // Para setThreadCount
+#include "../common/sintetico.hpp"          // Para escribirImagenSintetica
+#include <gsl/span>                         // Para gsl::span
+#include <cstddef>                          // Para std::size_t
+#include <cstdint>                          // Para uint64_t
+#include <exception>                        // Para std::exception
+#include <iostream>                         // Para std::cerr
+#include <stdexcept>                        // Para std::invalid_argument
+#include <string>                           // Para std::string, std::stoi
+#include <string_view>                      // Para std::string_view
+#include <vector>                           // Para std::vector
+
+namespace {
+  constexpr int MAX_VALUE_DEFECTO = 255;
+  constexpr std::size_t COLORES_DEFECTO = 256;
+  constexpr double ZIPF_DEFECTO = 1.0;
+  constexpr std::size_t PARAMETROS_POSICIONALES = 5;
+
+  constexpr std::string_view MAX_OPTION = "--max=";
+  constexpr std::string_view COLORS_OPTION = "--colors=";
+  constexpr std::string_view ZIPF_OPTION = "--zipf=";
+  constexpr std::string_view NOISE_OPTION = "--noise=";
+  constexpr std::string_view SEED_OPTION = "--seed=";
+  constexpr std::string_view THREADS_SHORT = "-j";
+  constexpr std::string_view THREADS_LONG = "--threads=";
+
+  struct ArgumentosImgen {
+    std::string salida;
+    OpcionesSintetico opciones;
+    std::size_t hilos;
+  };
+
+  // Aplica una opción --nombre=valor; devuelve false si `arg` no es una opción conocida
+  bool aplicarOpcion(const std::string& arg, ArgumentosImgen& args) {
+    const auto valor = [&arg](std::string_view prefijo) { return arg.substr(prefijo.size()); };
+    if (arg.starts_with(MAX_OPTION)) {
+      args.opciones.atributos.maxValue = std::stoi(valor(MAX_OPTION));
+    } else if (arg.starts_with(COLORS_OPTION)) {
+      args.opciones.colores = std::stoul(valor(COLORS_OPTION));
+    } else if (arg.starts_with(ZIPF_OPTION)) {
+      args.opciones.zipf = std::stod(valor(ZIPF_OPTION));
+    } else if (arg.starts_with(NOISE_OPTION)) {
+      args.opciones.ruido = std::stoi(valor(NOISE_OPTION));
+    } else if (arg.starts_with(SEED_OPTION)) {
+      args.opciones.semilla = static_cast<uint64_t>(std::stoull(valor(SEED_OPTION)));
+    } else if (arg.starts_with(THREADS_LONG)) {
+      args.hilos = std::stoul(valor(THREADS_LONG));
+    } else if (arg.starts_with(THREADS_SHORT) && arg.size() > THREADS_SHORT.size()) {
+      args.hilos = std::stoul(valor(THREADS_SHORT));
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  ArgumentosImgen leerArgumentos(int argc, char** argv) {
+    const gsl::span rawArgs{argv, static_cast<std::size_t>(argc)};
+    ArgumentosImgen args{.salida = {},
+                         .opciones = {.atributos = {.width = 0, .height = 0, .maxValue = MAX_VALUE_DEFECTO},
+                                      .patron = PatronSintetico::degradado,
+                                      .colores = COLORES_DEFECTO,
+                                      .zipf = ZIPF_DEFECTO,
+                                      .ruido = 0,
+                                      .semilla = 1},
+                         .hilos = 0};
+    std::vector<std::string> posicionales;
+    for (std::size_t i = 0; i < rawArgs.size(); ++i) {
+      const std::string arg = rawArgs[i];
+      if (arg == THREADS_SHORT && i + 1 < rawArgs.size()) {
+        args.hilos = std::stoul(rawArgs[++i]);
+      } else if (!aplicarOpcion(arg, args)) {
+        posicionales.push_back(arg);
+      }
+    }
+    if (posicionales.size() != PARAMETROS_POSICIONALES) {
+      throw std::invalid_argument("Usage: imgen <output.ppm> <width> <height> <gradient|noise|regions|palette> "
+                                  "[--max=N] [--colors=N] [--zipf=S] [--noise=N] [--seed=N]");
+    }
+    args.salida = posicionales[1];
+    args.opciones.atributos.width = std::stoi(posicionales[2]);
+    args.opciones.atributos.height = std::stoi(posicionales[3]);
+    args.opciones.patron = leerPatronSintetico(posicionales[4]);
+    return args;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  try {
+    const ArgumentosImgen args = leerArgumentos(argc, argv);
+    if (args.hilos > 0) {
+      setThreadCount(args.hilos);
+    }
+    if (!escribirImagenSintetica(args.salida, args.opciones)) {
+      return -1;
+    }
+    return 0;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return -1;
+  }
+}
@@ -28,4 +28,16 @@ struct FilePaths {
  */
 void performMaxLevelOperation(const FilePaths& paths, int newMaxValue);
 
+/**
+ * @brief Cambia el valor máximo de una imagen ya cargada en memoria.
+ *
+ * Si la profundidad de los componentes (8 o 16 bits) no cambia, los valores se
+ * escalan sobre el propio búfer de la imagen, sin reservar una segunda copia.
+ *
+ * @param image Imagen a modificar
+ * @param newMaxValue Nuevo valor máximo para los colores (1-65535)
+ * @throws std::invalid_argument si newMaxValue está fuera del rango válido
+ */
+void applyMaxLevel(PPMImageSoA& image, int newMaxValue);
+
 #endif // MAXLEVEL_HPP
\ No newline at end of file
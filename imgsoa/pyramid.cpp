@@ -0,0 +1,104 @@
+// File: imgsoa/pyramid.cpp
+#include "pyramid.hpp"
+#include "../common/binario.hpp"
+#include "../common/estadisticas.hpp"
+#include "../common/escalado.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  constexpr int MAX_VALUE_8BIT = 255;
+
+  void validateLevels(int levels) {
+    if (levels < 0) {
+      throw std::invalid_argument("Número de niveles fuera de rango.");
+    }
+  }
+
+  // Planos de una imagen SOA como bytes, en el almacenamiento de su profundidad
+  template <typename Imagen>
+  auto bytesCanales(Imagen& imagen) {
+    const auto bytesDePlanos = [](auto& planos) {
+      return std::array{bytesDe(planos.plano(0)), bytesDe(planos.plano(1)), bytesDe(planos.plano(2))};
+    };
+    if (imagen.maxValue > MAX_VALUE_8BIT) {
+      return bytesDePlanos(imagen.planos16);
+    }
+    return bytesDePlanos(imagen.planos);
+  }
+
+  // Bytes entre el inicio de dos filas de los planos de una imagen SOA
+  std::size_t bytesPaso(const PPMImageSoA& imagen) {
+    if (imagen.maxValue > MAX_VALUE_8BIT) {
+      return imagen.planos16.paso() * sizeof(uint16_t);
+    }
+    return imagen.planos.paso();
+  }
+
+  // Reduce la imagen a la mitad en cada eje con la media de cada bloque de 2x2, canal a
+  // canal y con el mismo plan para los tres canales
+  PPMImageSoA reducirMitad(const PPMImageSoA& imagen) {
+    const std::size_t bytes = (imagen.maxValue > MAX_VALUE_8BIT) ? 2 : 1;
+    PPMImageSoA reducida(PPMAttributes{.width = tamanoNivelPiramide(imagen.width),
+                                       .height = tamanoNivelPiramide(imagen.height),
+                                       .maxValue = imagen.maxValue});
+    const auto width = static_cast<std::size_t>(reducida.width);
+    const auto height = static_cast<std::size_t>(reducida.height);
+    if (bytes == 2) {
+      reducida.planos16 = PlanosAlineados<uint16_t>(width, height);
+    } else {
+      reducida.planos = PlanosAlineados<uint8_t>(width, height);
+    }
+
+    const auto origen = bytesCanales(imagen);
+    const auto destino = bytesCanales(reducida);
+    const auto planoOrigen = [&](std::span<uint8_t const> canal) {
+      return PlanoOrigen{.datos = canal,
+                         .width = static_cast<std::size_t>(imagen.width),
+                         .height = static_cast<std::size_t>(imagen.height),
+                         .canales = 1,
+                         .bytesPorComponente = bytes,
+                         .bytesPaso = bytesPaso(imagen)};
+    };
+    const auto planoDestino = [&](std::span<uint8_t> canal) {
+      return PlanoDestino{.datos = canal, .width = width, .height = height, .bytesPaso = bytesPaso(reducida)};
+    };
+    const PlanEscalado plan = crearPlanEscalado(FiltroEscalado::area, planoOrigen(origen[0]), planoDestino(destino[0]));
+    for (std::size_t canal = 0; canal < origen.size(); ++canal) {
+      escalarPlano(plan, planoOrigen(origen[canal]), planoDestino(destino[canal]));
+    }
+    return reducida;
+  }
+}
+
+void performPyramidOperation(const std::string& inputFile, const std::string& outputFile, int levels) {
+  std::cout << "Realizando la operación pyramid en imgsoa con " << levels << " niveles\n";
+  std::cout << "Archivo de entrada: " << inputFile << "\n";
+  validateLevels(levels);
+
+  PPMImageSoA nivelActual{};
+  if (!leerImagenPPMSoA(inputFile, nivelActual)) {
+    throw std::runtime_error("Error al leer el archivo de entrada");
+  }
+
+  // Cada nivel se calcula a partir del anterior, no de la imagen original
+  for (int nivel = 1; (levels == 0 || nivel <= levels) && (nivelActual.width > 1 || nivelActual.height > 1);
+       ++nivel) {
+    {
+      const FaseMedida fase{"kernel"};
+      nivelActual = reducirMitad(nivelActual);
+    }
+    const std::string rutaNivel = rutaNivelPiramide(outputFile, nivel);
+    if (!escribirImagenPPMSoAPorFilas(rutaNivel, nivelActual)) {
+      throw std::runtime_error("Error al escribir el archivo de salida");
+    }
+    std::cout << "Nivel " << nivel << " (" << nivelActual.width << "x" << nivelActual.height << "): " << rutaNivel
+              << "\n";
+  }
+  std::cout << "Operación completada exitosamente.\n";
+}
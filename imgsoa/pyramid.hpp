@@ -0,0 +1,22 @@
+// File: imgsoa/pyramid.hpp
+#ifndef PYRAMID_HPP
+#define PYRAMID_HPP
+
+#include <string>
+
+/**
+ * @brief Genera una pirámide de resoluciones a partir de una imagen P6 PPM.
+ *
+ * Cada nivel mide la mitad que el anterior en cada eje y se calcula a partir de él
+ * con la media de cada bloque de 2x2 píxeles, de modo que la imagen original se lee
+ * una sola vez. El nivel n se guarda en "<salida sin extensión>-n<extensión>".
+ *
+ * @param inputFile Ruta del archivo de imagen PPM de entrada
+ * @param outputFile Ruta base de los niveles generados
+ * @param levels Número de niveles a generar (0 para llegar hasta 1x1)
+ * @throws std::invalid_argument si levels es negativo.
+ * @throws std::runtime_error si ocurre un error al leer o escribir algún archivo.
+ */
+void performPyramidOperation(const std::string& inputFile, const std::string& outputFile, int levels);
+
+#endif // PYRAMID_HPP
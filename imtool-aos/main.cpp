@@ -1,15 +1,21 @@
 // File: imtool-aos/main.cpp
 #include "../common/progargs.hpp"           // Para ProgramArgs
+#include "../common/parallel.hpp"           // Para setThreadCount, setThreadPinning
+#include "../common/estadisticas.hpp"       // Para activarEstadisticas, FaseMedida, activarContadoresHardware
+#include "../common/traza.hpp"              // Para activarTraza, nombrarHiloTraza, escribirTraza
+#include "../common/isa.hpp"                // Para forzarNivelISA, leerNivelISA
 #include "../imgaos/maxlevel.hpp"           // Para performMaxLevelOperation
 #include "../common/binario.hpp"            // Para leerImagenPPM, escribirImagenPPM, info
 #include "../imgaos/cutfreq.hpp"            // Para cutfreq
 #include "../imgaos/resize.hpp"             // Para performResizeOperation
+#include "../imgaos/pyramid.hpp"            // Para performPyramidOperation
 #include "../common/info.hpp"               // Para info
 #include "../imgaos/compress.hpp"           // Para compress
 #include <iostream>                         // Para std::cout, std::cerr
 #include <exception>                        // Para std::exception
 #include <stdexcept>                        // Para std::invalid_argument
 #include <string>                           // Para std::string
+#include <cstddef>                          // Para std::size_t
 
 namespace {
   using namespace common;
@@ -39,7 +45,8 @@ namespace {
 
   // Función para validar parámetros de la operación "resize"
   void validateResizeParams(const ProgramArgs& args) {
-    if (args.getAdditionalParams().size() != 2) {
+    const std::size_t count = args.getAdditionalParams().size();
+    if (count != 2 && count != 3) {
       throw std::invalid_argument("Invalid number of extra arguments for resize: " +
                                   std::to_string(args.getAdditionalParams().size() + 3));
     }
@@ -59,7 +66,12 @@ namespace {
     validateResizeParams(args);
     const int newWidth = std::stoi(args.getAdditionalParams()[0]);
     const int newHeight = std::stoi(args.getAdditionalParams()[1]);
-    performResizeOperation(args.getInputFile(), args.getOutputFile(), newWidth, newHeight);
+    // El tercer parámetro opcional elige el filtro: nearest, bilinear (por defecto) o area
+    const FiltroEscalado filtro = (args.getAdditionalParams().size() == 3)
+                                      ? leerFiltroEscalado(args.getAdditionalParams()[2])
+                                      : FiltroEscalado::bilineal;
+    performResizeOperation(args.getInputFile(), args.getOutputFile(),
+                           {.width = newWidth, .height = newHeight, .filtro = filtro});
   }
 
   bool validarParametrosCutfreq(const ProgramArgs& args, int& number) {
@@ -113,6 +125,16 @@ namespace {
     return 0;
   }
 
+  // Procesa la operación "pyramid": el parámetro opcional es el número de niveles
+  void processPyramid(const ProgramArgs& args) {
+    if (args.getAdditionalParams().size() > 1) {
+      throw std::invalid_argument("Invalid number of extra arguments for pyramid: " +
+                                  std::to_string(args.getAdditionalParams().size() + 3));
+    }
+    const int levels = args.getAdditionalParams().empty() ? 0 : std::stoi(args.getAdditionalParams()[0]);
+    performPyramidOperation(args.getInputFile(), args.getOutputFile(), levels);
+  }
+
   void processInfo(const ProgramArgs& args) {
     info(args.getInputFile());
   }
@@ -128,17 +150,9 @@ namespace {
       throw std::runtime_error("Fallo en la operación 'compress'");
     }
   }
-}
-
-int main(int argc, char* argv[]) {
-  try {
-    const ProgramArgs args(argc, argv);
-
-    PPMImage image;
-    if (!leerImagenPPM(args.getInputFile(), image)) {
-      return -1;
-    }
 
+  // Ejecuta la operación pedida en la línea de órdenes
+  void runOperation(const ProgramArgs& args) {
     if (args.getOperation() == "maxlevel") {
       processMaxlevel(args);
     }
@@ -148,6 +162,9 @@ int main(int argc, char* argv[]) {
     else if (args.getOperation() == "cutfreq") {
       processCutFreq(args);
     }
+    else if (args.getOperation() == "pyramid") {
+      processPyramid(args);
+    }
     else if (args.getOperation() == "info") {
       processInfo(args);
     }
@@ -157,6 +174,48 @@ int main(int argc, char* argv[]) {
     else {
       throw std::invalid_argument("Operación no válida");
     }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  try {
+    const ProgramArgs args(argc, argv);
+    if (args.getThreadCount() > 0) {
+      setThreadCount(args.getThreadCount());
+    }
+    setThreadPinning(args.getPinThreads());
+    if (args.getStats()) {
+      activarEstadisticas(args.getStatsFile());
+    }
+    if (args.getCounters()) {
+      // Sin contadores se sigue con el informe de tiempos
+      (void)activarContadoresHardware();
+    }
+    if (!args.getTraceFile().empty()) {
+      activarTraza(args.getTraceFile());
+      nombrarHiloTraza("main");
+    }
+    if (!args.getIsaLevel().empty()) {
+      forzarNivelISA(leerNivelISA(args.getIsaLevel()));
+    }
+
+    // Solo se valida la cabecera: cada operación lee los píxeles que necesita
+    LectorPPMPorFilas entrada;
+    if (!entrada.abrir(args.getInputFile())) {
+      return -1;
+    }
+
+    {
+      const FaseMedida fase{args.getOperation()};
+      runOperation(args);
+    }
+    if (!escribirEstadisticas({.herramienta = "imtool-aos", .operacion = args.getOperation(),
+                               .entrada = args.getInputFile(), .salida = args.getOutputFile()})) {
+      return -1;
+    }
+    if (!escribirTraza()) {
+      return -1;
+    }
 
     return 0;
 
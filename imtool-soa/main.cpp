@@ -1,7 +1,12 @@
 // File: imtool-soa/main.cpp
 #include "../common/progargs.hpp"           // Para ProgramArgs
+#include "../common/parallel.hpp"           // Para setThreadCount, setThreadPinning
+#include "../common/estadisticas.hpp"       // Para activarEstadisticas, FaseMedida, activarContadoresHardware
+#include "../common/traza.hpp"              // Para activarTraza, nombrarHiloTraza, escribirTraza
+#include "../common/isa.hpp"                // Para forzarNivelISA, leerNivelISA
 #include "../imgsoa/maxlevel.hpp"           // Para performMaxLevelOperation
 #include "../imgsoa/resize.hpp"             // Para performResizeOperation
+#include "../imgsoa/pyramid.hpp"            // Para performPyramidOperation
 #include "../common/binario.hpp"            // Para leerImagenPPMSoA, escribirImagenPPMSoA
 #include "../common/info.hpp"               // Para processInfo
 #include "../imgsoa/compress.hpp"           // Para processCompress
@@ -10,6 +15,7 @@
 #include <exception>                        // Para std::exception
 #include <stdexcept>                        // Para std::invalid_argument
 #include <string>                           // Para std::string
+#include <cstddef>                          // Para std::size_t
 
 namespace {
   using namespace common;
@@ -39,7 +45,8 @@ namespace {
 
   // Función para validar parámetros de la operación "resize"
   void validateResizeParams(const ProgramArgs& args) {
-    if (args.getAdditionalParams().size() != 2) {
+    const std::size_t count = args.getAdditionalParams().size();
+    if (count != 2 && count != 3) {
       throw std::invalid_argument("Invalid number of extra arguments for resize: " +
                                   std::to_string(args.getAdditionalParams().size() + 3));
     }
@@ -59,7 +66,22 @@ namespace {
     validateResizeParams(args);
     const int newWidth = std::stoi(args.getAdditionalParams()[0]);
     const int newHeight = std::stoi(args.getAdditionalParams()[1]);
-    performResizeOperation(args.getInputFile(), args.getOutputFile(), newWidth, newHeight);
+    // El tercer parámetro opcional elige el filtro: nearest, bilinear (por defecto) o area
+    const FiltroEscalado filtro = (args.getAdditionalParams().size() == 3)
+                                      ? leerFiltroEscalado(args.getAdditionalParams()[2])
+                                      : FiltroEscalado::bilineal;
+    performResizeOperation(args.getInputFile(), args.getOutputFile(),
+                           {.width = newWidth, .height = newHeight, .filtro = filtro});
+  }
+
+  // Procesa la operación "pyramid": el parámetro opcional es el número de niveles
+  void processPyramid(const ProgramArgs& args) {
+    if (args.getAdditionalParams().size() > 1) {
+      throw std::invalid_argument("Invalid number of extra arguments for pyramid: " +
+                                  std::to_string(args.getAdditionalParams().size() + 3));
+    }
+    const int levels = args.getAdditionalParams().empty() ? 0 : std::stoi(args.getAdditionalParams()[0]);
+    performPyramidOperation(args.getInputFile(), args.getOutputFile(), levels);
   }
 
   void processInfo(const ProgramArgs& args) {
@@ -97,23 +119,18 @@ namespace {
       throw std::runtime_error("Error al escribir la imagen en formato SOA.");
     }
   }
-}  // namespace
-
-int main(int argc, char* argv[]) {
-  try {
-    const ProgramArgs args(argc, argv);
-
-    PPMImageSoA image;
-    if (!leerImagenPPMSoA(args.getInputFile(), image)) {
-      return -1;
-    }
 
+  // Ejecuta la operación pedida en la línea de órdenes
+  void runOperation(const ProgramArgs& args) {
     if (args.getOperation() == "maxlevel") {
       processMaxlevel(args);
     }
     else if (args.getOperation() == "resize") {
       processResize(args);
     }
+    else if (args.getOperation() == "pyramid") {
+      processPyramid(args);
+    }
     else if (args.getOperation() == "info") {
       processInfo(args);
     }
@@ -126,6 +143,48 @@ int main(int argc, char* argv[]) {
     else {
       throw std::invalid_argument("Operación no válida");
     }
+  }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const ProgramArgs args(argc, argv);
+    if (args.getThreadCount() > 0) {
+      setThreadCount(args.getThreadCount());
+    }
+    setThreadPinning(args.getPinThreads());
+    if (args.getStats()) {
+      activarEstadisticas(args.getStatsFile());
+    }
+    if (args.getCounters()) {
+      // Sin contadores se sigue con el informe de tiempos
+      (void)activarContadoresHardware();
+    }
+    if (!args.getTraceFile().empty()) {
+      activarTraza(args.getTraceFile());
+      nombrarHiloTraza("main");
+    }
+    if (!args.getIsaLevel().empty()) {
+      forzarNivelISA(leerNivelISA(args.getIsaLevel()));
+    }
+
+    // Solo se valida la cabecera: cada operación lee los píxeles que necesita
+    LectorPPMPorFilas entrada;
+    if (!entrada.abrir(args.getInputFile())) {
+      return -1;
+    }
+
+    {
+      const FaseMedida fase{args.getOperation()};
+      runOperation(args);
+    }
+    if (!escribirEstadisticas({.herramienta = "imtool-soa", .operacion = args.getOperation(),
+                               .entrada = args.getInputFile(), .salida = args.getOutputFile()})) {
+      return -1;
+    }
+    if (!escribirTraza()) {
+      return -1;
+    }
 
     return 0;
 
@@ -88,9 +88,9 @@ TEST(BinarioTest, LeerImagenPPMSoA_CorrectChannels) {
     EXPECT_EQ(imageSoA.width, 2);
     EXPECT_EQ(imageSoA.height, 2);
     EXPECT_EQ(imageSoA.maxValue, MAX_COLOR_VALUE);
-    EXPECT_EQ(imageSoA.redChannel, std::vector<uint8_t>({MAX_COLOR_VALUE, 0, 0, MAX_COLOR_VALUE}));
-    EXPECT_EQ(imageSoA.greenChannel, std::vector<uint8_t>({0, MAX_COLOR_VALUE, 0, MAX_COLOR_VALUE}));
-    EXPECT_EQ(imageSoA.blueChannel, std::vector<uint8_t>({0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE}));
+    EXPECT_EQ(imageSoA.planos.canal(0), std::vector<uint8_t>({MAX_COLOR_VALUE, 0, 0, MAX_COLOR_VALUE}));
+    EXPECT_EQ(imageSoA.planos.canal(1), std::vector<uint8_t>({0, MAX_COLOR_VALUE, 0, MAX_COLOR_VALUE}));
+    EXPECT_EQ(imageSoA.planos.canal(2), std::vector<uint8_t>({0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE}));
     (void)std::remove(filePath.c_str());
 }
 
@@ -100,9 +100,9 @@ TEST(BinarioTest, EscribirImagenPPMSoA_WriteReadCycle) {
     imageSoA.width = 2;
     imageSoA.height = 2;
     imageSoA.maxValue = MAX_COLOR_VALUE;
-    imageSoA.redChannel = {MAX_COLOR_VALUE, 0, 0, MAX_COLOR_VALUE};
-    imageSoA.greenChannel = {0, MAX_COLOR_VALUE, 0, MAX_COLOR_VALUE};
-    imageSoA.blueChannel = {0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE};
+    imageSoA.planos = PlanosAlineados<uint8_t>(2, 2, {std::vector<uint8_t>{MAX_COLOR_VALUE, 0, 0, MAX_COLOR_VALUE},
+                                                      std::vector<uint8_t>{0, MAX_COLOR_VALUE, 0, MAX_COLOR_VALUE},
+                                                      std::vector<uint8_t>{0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE}});
 
     EXPECT_TRUE(escribirImagenPPMSoA(filePath, imageSoA));
 
@@ -111,9 +111,9 @@ TEST(BinarioTest, EscribirImagenPPMSoA_WriteReadCycle) {
     EXPECT_EQ(readImageSoA.width, imageSoA.width);
     EXPECT_EQ(readImageSoA.height, imageSoA.height);
     EXPECT_EQ(readImageSoA.maxValue, imageSoA.maxValue);
-    EXPECT_EQ(readImageSoA.redChannel, imageSoA.redChannel);
-    EXPECT_EQ(readImageSoA.greenChannel, imageSoA.greenChannel);
-    EXPECT_EQ(readImageSoA.blueChannel, imageSoA.blueChannel);
+    EXPECT_EQ(readImageSoA.planos.canal(0), imageSoA.planos.canal(0));
+    EXPECT_EQ(readImageSoA.planos.canal(1), imageSoA.planos.canal(1));
+    EXPECT_EQ(readImageSoA.planos.canal(2), imageSoA.planos.canal(2));
     (void)std::remove(filePath.c_str());
 }
 
@@ -133,6 +133,84 @@ TEST(BinarioTest, LeerImagenCPPM_ValidHeaderAndTable) {
     EXPECT_EQ(image.width, 2);
     EXPECT_EQ(image.height, 2);
     EXPECT_EQ(image.maxValue, MAX_COLOR_VALUE);
-    EXPECT_EQ(image.pixelData, std::vector<uint8_t>({MAX_COLOR_VALUE, 0, 0, 0, MAX_COLOR_VALUE, 0, 0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE, MAX_COLOR_VALUE, MAX_COLOR_VALUE}));
+    EXPECT_EQ(image.pixelData, VectorReserva<uint8_t>({MAX_COLOR_VALUE, 0, 0, 0, MAX_COLOR_VALUE, 0, 0, 0, MAX_COLOR_VALUE, MAX_COLOR_VALUE, MAX_COLOR_VALUE, MAX_COLOR_VALUE}));
+    (void)std::remove(filePath.c_str());
+}
+
+TEST(BinarioTest, LeerImagenPPM_SixteenBitAsNativeWords) {
+    const std::string filePath = "./test_image_16bit.ppm";
+    std::ofstream file(filePath, std::ios::binary);
+    file << "P6\n1 1\n65535\n";
+    file.put(1).put(2).put(3).put(4).put(5).put(6);
+    file.close();
+
+    // Cada componente se convierte una vez del orden del archivo (byte alto primero)
+    PPMImage image;
+    ASSERT_TRUE(leerImagenPPM(filePath, image));
+    EXPECT_TRUE(image.pixelData.empty());
+    EXPECT_EQ(image.pixelData16, VectorReserva<uint16_t>({0x0102, 0x0304, 0x0506}));
+
+    PPMImageSoA imageSoA;
+    ASSERT_TRUE(leerImagenPPMSoA(filePath, imageSoA));
+    EXPECT_TRUE(imageSoA.planos.vacio());
+    EXPECT_EQ(imageSoA.planos16.canal(0), std::vector<uint16_t>({0x0102}));
+    EXPECT_EQ(imageSoA.planos16.canal(2), std::vector<uint16_t>({0x0506}));
+
+    // Y al escribir vuelve al orden del archivo
+    ASSERT_TRUE(escribirImagenPPMSoAPorFilas(filePath, imageSoA));
+    PPMImage releida;
+    ASSERT_TRUE(leerImagenPPM(filePath, releida));
+    EXPECT_EQ(releida.pixelData16, image.pixelData16);
+    (void)std::remove(filePath.c_str());
+}
+
+TEST(BinarioTest, LectorPPMPorFilas_ReadsRowsInFileOrder) {
+    const std::string filePath = "./test_image_rows.ppm";
+    std::ofstream file(filePath, std::ios::binary);
+    file << "P6\n1 2\n65535\n";
+    file.put(1).put(2).put(3).put(4).put(5).put(6);   // Fila 0
+    file.put(7).put(8).put(9).put(10).put(11).put(12); // Fila 1
+    file.close();
+
+    LectorPPMPorFilas lector;
+    ASSERT_TRUE(lector.abrir(filePath));
+    EXPECT_EQ(lector.atributos().height, 2);
+    ASSERT_EQ(lector.bytesPorFila(), 6U);
+
+    // Los componentes de 16 bits se entregan tal como están en el archivo
+    std::vector<uint8_t> fila(lector.bytesPorFila());
+    ASSERT_TRUE(lector.leerFila(fila));
+    EXPECT_EQ(fila, std::vector<uint8_t>({1, 2, 3, 4, 5, 6}));
+    ASSERT_TRUE(lector.leerFila(fila));
+    EXPECT_EQ(fila, std::vector<uint8_t>({7, 8, 9, 10, 11, 12}));
+    EXPECT_FALSE(lector.leerFila(fila));
+    (void)std::remove(filePath.c_str());
+}
+
+TEST(BinarioTest, LectorPPMPorFilas_RejectsTruncatedBody) {
+    const std::string filePath = "./test_image_truncated.ppm";
+    std::ofstream file(filePath, std::ios::binary);
+    file << "P6\n1 2\n" << MAX_COLOR_VALUE << "\n";
+    file.put(1).put(2).put(3).put(4).put(5);  // Falta el último byte de la fila 1
+    file.close();
+
+    LectorPPMPorFilas lector;
+    EXPECT_FALSE(lector.abrir(filePath));
+    (void)std::remove(filePath.c_str());
+}
+
+TEST(BinarioTest, LectorPPMPorFilas_SkipsRowsWithoutReading) {
+    const std::string filePath = "./test_image_skip.ppm";
+    std::ofstream file(filePath, std::ios::binary);
+    file << "P6\n1 3\n" << MAX_COLOR_VALUE << "\n";
+    file.put(1).put(2).put(3).put(4).put(5).put(6).put(7).put(8).put(9);
+    file.close();
+
+    LectorPPMPorFilas lector;
+    ASSERT_TRUE(lector.abrir(filePath));
+    std::vector<uint8_t> fila(lector.bytesPorFila());
+    ASSERT_TRUE(lector.saltarFilas(2));
+    ASSERT_TRUE(lector.leerFila(fila));
+    EXPECT_EQ(fila, std::vector<uint8_t>({7, 8, 9}));
     (void)std::remove(filePath.c_str());
 }
@@ -0,0 +1,41 @@
+// File: utest-common/contadores-test.cpp
+#include "../common/contadores.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace {
+  constexpr std::size_t LOOP_ITERATIONS = 1000000;
+  constexpr uint64_t MIN_INSTRUCTIONS = 1000000;
+}
+
+TEST(ContadoresTest, NamesMatchReportKeys) {
+    EXPECT_EQ(std::string(nombreContador(Contador::ciclos)), "cycles");
+    EXPECT_EQ(std::string(nombreContador(Contador::instrucciones)), "instructions");
+    EXPECT_EQ(std::string(nombreContador(Contador::fallosL1)), "l1d_misses");
+    EXPECT_EQ(std::string(nombreContador(Contador::fallosLLC)), "llc_misses");
+    EXPECT_EQ(std::string(nombreContador(Contador::fallosSalto)), "branch_misses");
+}
+
+// En máquinas sin contadores (o con perf_event_paranoid restrictivo) solo se comprueba
+// que el fallo se explica y que las lecturas valen 0
+TEST(ContadoresTest, CountsInstructionsOrExplainsWhyNot) {
+    ContadoresHardware contadores;
+    if (!contadores.abrir()) {
+        EXPECT_FALSE(contadores.error().empty());
+        EXPECT_EQ(contadores.leer(), LecturaContadores{});
+        GTEST_SKIP() << "Contadores hardware no disponibles: " << contadores.error();
+    }
+    if (!contadores.disponible(Contador::instrucciones)) {
+        GTEST_SKIP() << "Contador de instrucciones no disponible";
+    }
+    const LecturaContadores antes = contadores.leer();
+    volatile std::size_t suma = 0;
+    for (std::size_t i = 0; i < LOOP_ITERATIONS; ++i) {
+        suma = suma + i;
+    }
+    const LecturaContadores despues = contadores.leer();
+    const auto indice = static_cast<std::size_t>(Contador::instrucciones);
+    EXPECT_GE(despues.at(indice) - antes.at(indice), MIN_INSTRUCTIONS);
+}
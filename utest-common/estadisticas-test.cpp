@@ -0,0 +1,74 @@
+// File: utest-common/estadisticas-test.cpp
+#include "../common/estadisticas.hpp"
+#include "../common/reserva.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+
+namespace {
+  constexpr int INNER_CALLS = 3;
+  constexpr std::size_t POOL_BYTES = std::size_t{1} << 20U;
+
+  std::string leerArchivo(const std::string& filePath) {
+    const std::ifstream file(filePath);
+    std::stringstream contenido;
+    contenido << file.rdbuf();
+    return contenido.str();
+  }
+}
+
+TEST(EstadisticasTest, ReportsNestedPhasesAsJson) {
+    const std::string filePath = "./test_stats.json";
+    activarEstadisticas(filePath);
+    ASSERT_TRUE(estadisticasActivas());
+    {
+        const FaseMedida outer{"resize"};
+        for (int i = 0; i < INNER_CALLS; ++i) {
+            const FaseMedida inner{"read"};
+        }
+    }
+    ASSERT_TRUE(escribirEstadisticas({.herramienta = "imtool-aos", .operacion = "resize",
+                                      .entrada = "in \"a\".ppm", .salida = "out.ppm"}));
+
+    const std::string report = leerArchivo(filePath);
+    EXPECT_NE(report.find("\"tool\": \"imtool-aos\""), std::string::npos);
+    EXPECT_NE(report.find("\"input\": \"in \\\"a\\\".ppm\""), std::string::npos);
+    EXPECT_NE(report.find("{\"name\": \"resize\", \"calls\": 1,"), std::string::npos);
+    EXPECT_NE(report.find("{\"name\": \"resize/read\", \"calls\": 3,"), std::string::npos);
+    EXPECT_NE(report.find("\"total_ms\": "), std::string::npos);
+    EXPECT_NE(report.find("\"memory\": {\"allocated_bytes\": "), std::string::npos);
+    EXPECT_NE(report.find("\"peak_bytes\": "), std::string::npos);
+    EXPECT_NE(report.find("\"buffer_pool\": {\"reused\": "), std::string::npos);
+    EXPECT_NE(report.find("\"huge_pages\": {\"enabled\": "), std::string::npos);
+    EXPECT_NE(report.find("\"thp_mode\": \""), std::string::npos);
+    (void)std::remove(filePath.c_str());
+}
+
+// Los búferes de la reserva se cuentan aunque no se haya sustituido operator new
+TEST(EstadisticasTest, CountsPoolBuffersPerPhase) {
+    const std::string filePath = "./test_stats_pool.json";
+    activarEstadisticas(filePath);
+    {
+        const FaseMedida phase{"pool-buffers"};
+        VectorReserva<uint8_t> buffer(POOL_BYTES);
+        buffer.back() = 1;
+        EXPECT_EQ(buffer.back(), 1);
+    }
+    ASSERT_TRUE(escribirEstadisticas({.herramienta = "imtool-aos", .operacion = "maxlevel",
+                                      .entrada = "in.ppm", .salida = "out.ppm"}));
+
+    const std::string report = leerArchivo(filePath);
+    const std::regex phasePattern{R"(\{"name": "pool-buffers", "calls": 1, "total_ms": [0-9.]+, )"
+                                  R"("allocated_bytes": ([0-9]+), "allocations": ([0-9]+), "peak_bytes": ([0-9]+))"};
+    std::smatch match;
+    ASSERT_TRUE(std::regex_search(report, match, phasePattern)) << report;
+    EXPECT_GE(std::stoull(match[1].str()), POOL_BYTES);
+    EXPECT_GE(std::stoull(match[2].str()), 1U);
+    EXPECT_GE(std::stoull(match[3].str()), POOL_BYTES);
+    (void)std::remove(filePath.c_str());
+}
@@ -0,0 +1,131 @@
+// File: utest-common/imagen-test.cpp
+#include "../common/imagen.hpp"
+#include "../common/frecuencias.hpp"
+#include "../common/niveles.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+  constexpr int LADO = 7;
+  constexpr std::size_t PIXELES = static_cast<std::size_t>(LADO) * LADO;
+  constexpr int MAX_16BIT = 1000;
+  constexpr uint32_t COMPONENTE_16BIT = 0x1234;
+  constexpr uint32_t COMPONENTE_8BIT = 0xAB;
+  constexpr std::size_t PIXEL_PRUEBA = 5;
+  constexpr std::size_t FILA_PRUEBA = 2;
+
+  // Imagen AOS de 16 bits con pocos colores repetidos, para que cutfreq tenga empates
+  PPMImage imagenIntercalada16() {
+    PPMImage image{{.width = LADO, .height = LADO, .maxValue = MAX_16BIT}};
+    dimensionarComponentes<uint16_t>(image, LADO, LADO);
+    const auto vista = vistaImagen<uint16_t>(image);
+    for (std::size_t y = 0; y < vista.alto(); ++y) {
+      for (std::size_t x = 0; x < vista.ancho(); ++x) {
+        const std::size_t pixel = (y * vista.ancho()) + x;
+        for (std::size_t canal = 0; canal < CANALES_RGB; ++canal) {
+          vista.fila(y).escribir(x, canal, static_cast<uint32_t>(((pixel % 5) * 211 + canal * 97) % MAX_16BIT));
+        }
+      }
+    }
+    return image;
+  }
+
+  PPMImageSoA comoPlanar(const PPMImage& image) {
+    PPMImageSoA planar{{.width = image.width, .height = image.height, .maxValue = image.maxValue}};
+    segunProfundidad(image.maxValue, [&]<typename T>(T) {
+      const auto origen = vistaImagen<T>(image);
+      dimensionarComponentes<T>(planar, origen.ancho(), origen.alto());
+      const auto destino = vistaImagen<T>(planar);
+      for (std::size_t y = 0; y < origen.alto(); ++y) {
+        for (std::size_t x = 0; x < origen.ancho(); ++x) {
+          for (std::size_t canal = 0; canal < CANALES_RGB; ++canal) {
+            destino.fila(y).escribir(x, canal, origen.fila(y).leer(x, canal));
+          }
+        }
+      }
+    });
+    return planar;
+  }
+
+  // Compara ambas disposiciones componente a componente
+  void esperarIguales(const PPMImage& intercalada, const PPMImageSoA& planar) {
+    ASSERT_EQ(intercalada.maxValue, planar.maxValue);
+    segunProfundidad(intercalada.maxValue, [&]<typename T>(T) {
+      const auto aos = vistaImagen<T>(intercalada);
+      const auto soa = vistaImagen<T>(planar);
+      ASSERT_EQ(aos.ancho(), soa.ancho());
+      ASSERT_EQ(aos.alto(), soa.alto());
+      for (std::size_t y = 0; y < aos.alto(); ++y) {
+        for (std::size_t x = 0; x < aos.ancho(); ++x) {
+          EXPECT_EQ(claveColor(aos.fila(y), x), claveColor(soa.fila(y), x)) << "píxel " << x << ", " << y;
+        }
+      }
+    });
+  }
+}  // namespace
+
+TEST(ImagenTest, SixteenBitViewUsesNativeWords) {
+    PPMImage image{{.width = LADO, .height = LADO, .maxValue = MAX_16BIT}};
+    dimensionarComponentes<uint16_t>(image, LADO, LADO);
+    EXPECT_TRUE(image.pixelData.empty());
+    const auto vista = vistaImagen<uint16_t>(image);
+    ASSERT_EQ(vista.pixeles(), PIXELES);
+    vista.escribir(1, 2, COMPONENTE_16BIT);
+    EXPECT_EQ(image.pixelData16[5], COMPONENTE_16BIT);
+    EXPECT_EQ(vista.leer(1, 2), COMPONENTE_16BIT);
+    EXPECT_EQ(vista.leerEnOrden(5), COMPONENTE_16BIT);
+}
+
+TEST(ImagenTest, PlanarViewAddressesEachChannelRow) {
+    PPMImageSoA image{{.width = LADO, .height = LADO, .maxValue = MAX_VALOR_8BIT}};
+    dimensionarComponentes<uint8_t>(image, LADO, LADO);
+    vistaImagen<uint8_t>(image).fila(FILA_PRUEBA).escribir(PIXEL_PRUEBA, 1, COMPONENTE_8BIT);
+    EXPECT_EQ(image.planos.fila(1, FILA_PRUEBA)[PIXEL_PRUEBA], COMPONENTE_8BIT);
+    EXPECT_EQ(image.planos.fila(0, FILA_PRUEBA)[PIXEL_PRUEBA], 0);
+    EXPECT_EQ(image.planos.canal(1)[(FILA_PRUEBA * LADO) + PIXEL_PRUEBA], COMPONENTE_8BIT);
+}
+
+TEST(ImagenTest, SubviewStartsAtRequestedRow) {
+    const PPMImage image = imagenIntercalada16();
+    const auto vista = vistaImagen<uint16_t>(image);
+    const auto cola = vista.subvista(FILA_PRUEBA, LADO - FILA_PRUEBA);
+    EXPECT_EQ(cola.pixeles(), (LADO - FILA_PRUEBA) * LADO);
+    EXPECT_EQ(claveColor(cola, PIXEL_PRUEBA), claveColor(vista.fila(FILA_PRUEBA), PIXEL_PRUEBA));
+    EXPECT_EQ(vista.subvista(LADO, 0).pixeles(), 0U);
+}
+
+TEST(ImagenTest, ColorKeyRoundTripsChannels) {
+    const PPMImage image = imagenIntercalada16();
+    const auto vista = vistaImagen<uint16_t>(image);
+    const ClaveColor color = claveColor(vista, PIXEL_PRUEBA);
+    for (std::size_t canal = 0; canal < CANALES_RGB; ++canal) {
+      EXPECT_EQ(canalDeClave(color, canal), vista.leer(PIXEL_PRUEBA, canal));
+    }
+}
+
+TEST(ImagenTest, VisitsEveryPixelOnce) {
+    const PPMImageSoA planar = comoPlanar(imagenIntercalada16());
+    std::size_t visitados = 0;
+    paraCadaPixel(vistaImagen<uint16_t>(planar), [&visitados](const auto&, std::size_t) { ++visitados; });
+    EXPECT_EQ(visitados, PIXELES);
+}
+
+TEST(ImagenTest, MaxLevelMatchesAcrossLayouts) {
+    for (const int nuevoMaximo : {MAX_VALOR_8BIT, MAX_16BIT * 3}) {
+      PPMImage intercalada = imagenIntercalada16();
+      PPMImageSoA planar = comoPlanar(intercalada);
+      aplicarNivelMaximo(intercalada, nuevoMaximo);
+      aplicarNivelMaximo(planar, nuevoMaximo);
+      esperarIguales(intercalada, planar);
+    }
+}
+
+TEST(ImagenTest, CutfreqMatchesAcrossLayouts) {
+    PPMImage intercalada = imagenIntercalada16();
+    PPMImageSoA planar = comoPlanar(intercalada);
+    eliminarColoresMenosFrecuentes(intercalada, 2);
+    eliminarColoresMenosFrecuentes(planar, 2);
+    esperarIguales(intercalada, planar);
+}
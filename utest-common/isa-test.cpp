@@ -0,0 +1,32 @@
+// File: utest-common/isa-test.cpp
+#include "../common/isa.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(IsaTest, NamesRoundTrip) {
+    for (const NivelISA nivel : {NivelISA::base, NivelISA::avx2, NivelISA::avx512}) {
+        EXPECT_EQ(leerNivelISA(nombreNivelISA(nivel)), nivel);
+    }
+    EXPECT_STREQ(nombreNivelISA(NivelISA::base), "baseline");
+}
+
+TEST(IsaTest, ThrowsOnUnknownLevel) {
+    EXPECT_THROW({ (void)leerNivelISA("sse9"); }, std::invalid_argument);
+}
+
+TEST(IsaTest, ForcedLevelSelectsVariant) {
+    constexpr VariantesISA<int> variantes{.base = 0, .avx2 = 1, .avx512 = 2};
+    forzarNivelISA(NivelISA::base);
+    EXPECT_EQ(nivelISA(), NivelISA::base);
+    EXPECT_EQ(elegirVariante(variantes), 0);
+
+    forzarNivelISA(nivelISADetectado());
+    EXPECT_EQ(elegirVariante(variantes), static_cast<int>(nivelISADetectado()));
+}
+
+TEST(IsaTest, ThrowsWhenForcingUnsupportedLevel) {
+    if (nivelISADetectado() == NivelISA::avx512) {
+        GTEST_SKIP() << "Este procesador admite todos los niveles";
+    }
+    EXPECT_THROW({ forzarNivelISA(NivelISA::avx512); }, std::invalid_argument);
+}
@@ -0,0 +1,45 @@
+// File: utest-common/memoria-test.cpp
+#include "../common/memoria.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+  constexpr std::size_t BUFFER_BYTES = std::size_t{1} << 20U;
+  constexpr std::size_t MANUAL_BYTES = 4096;
+}
+
+TEST(MemoriaTest, TracksManualAllocationsAndPeak) {
+    activarContadorMemoria();
+    const LecturaMemoria antes = leerMemoria();
+    const std::int64_t picoAnterior = reiniciarPico();
+    registrarAsignacion(MANUAL_BYTES);
+    registrarLiberacion(MANUAL_BYTES);
+    const LecturaMemoria despues = leerMemoria();
+    restaurarPico(picoAnterior);
+
+    EXPECT_GE(despues.bytes - antes.bytes, MANUAL_BYTES);
+    EXPECT_GE(despues.asignaciones - antes.asignaciones, 1U);
+    EXPECT_GE(despues.pico, antes.vivos + static_cast<std::int64_t>(MANUAL_BYTES));
+    EXPECT_GE(leerMemoria().pico, picoAnterior);
+}
+
+TEST(MemoriaTest, CountsOperatorNewWhenHooked) {
+    if (!contadorMemoriaGlobal()) {
+        GTEST_SKIP() << "Compilado sin IMTOOL_CONTAR_MEMORIA";
+    }
+    activarContadorMemoria();
+    const LecturaMemoria antes = leerMemoria();
+    {
+        std::vector<std::uint8_t> buffer(BUFFER_BYTES);
+        std::iota(buffer.begin(), buffer.end(), std::uint8_t{0});
+        EXPECT_EQ(buffer.back(), static_cast<std::uint8_t>(BUFFER_BYTES - 1));
+        const LecturaMemoria durante = leerMemoria();
+        EXPECT_GE(durante.bytes - antes.bytes, BUFFER_BYTES);
+        EXPECT_GE(durante.vivos - antes.vivos, static_cast<std::int64_t>(BUFFER_BYTES));
+    }
+    EXPECT_EQ(leerMemoria().vivos, antes.vivos);
+    EXPECT_GT(residenteMaximoKiB(), 0U);
+}
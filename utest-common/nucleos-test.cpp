@@ -0,0 +1,91 @@
+// File: utest-common/nucleos-test.cpp
+#include "../common/nucleos.hpp"
+#include "../common/isa.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+  // Tamaño con resto para que cada variante recorra también su cola escalar
+  constexpr std::size_t PIXELES = 1001;
+  constexpr std::size_t CANALES = 3;
+  constexpr uint32_t PASO_INDICE = 40503;
+  constexpr std::size_t BITS_BYTE = 8;
+  constexpr std::size_t BYTES_INDICE = 4;
+
+  std::vector<uint8_t> bytesDePrueba(std::size_t tamano) {
+    std::vector<uint8_t> datos(tamano);
+    for (std::size_t i = 0; i < tamano; ++i) {
+      datos[i] = static_cast<uint8_t>((i * 7) + (i >> 8U));
+    }
+    return datos;
+  }
+
+  // Ejecuta la prueba con cada nivel que admite el procesador y restaura el detectado
+  template <typename Prueba>
+  void conCadaNivel(Prueba prueba) {
+    for (const NivelISA nivel : {NivelISA::base, NivelISA::avx2, NivelISA::avx512}) {
+      if (nivel <= nivelISADetectado()) {
+        forzarNivelISA(nivel);
+        SCOPED_TRACE(nombreNivelISA(nivel));
+        prueba();
+      }
+    }
+    forzarNivelISA(nivelISADetectado());
+  }
+}  // namespace
+
+TEST(NucleosTest, SwapsBytesOfEachComponent) {
+    const std::vector<uint8_t> original = bytesDePrueba(PIXELES * 2);
+    conCadaNivel([&] {
+        std::vector<uint8_t> datos = original;
+        intercambiarBytes16(datos);
+        std::vector<uint8_t> copia(original.size());
+        copiarIntercambiando16(original, copia);
+        for (std::size_t i = 0; i < original.size(); i += 2) {
+            ASSERT_EQ(datos[i], original[i + 1]);
+            ASSERT_EQ(datos[i + 1], original[i]);
+        }
+        EXPECT_EQ(copia, datos);
+    });
+}
+
+TEST(NucleosTest, SplitAndInterleaveRoundTrip) {
+    for (const std::size_t bytes : {std::size_t{1}, std::size_t{2}}) {
+        const std::vector<uint8_t> intercalado = bytesDePrueba(PIXELES * CANALES * bytes);
+        conCadaNivel([&] {
+            std::vector<uint8_t> rojo(PIXELES * bytes);
+            std::vector<uint8_t> verde(PIXELES * bytes);
+            std::vector<uint8_t> azul(PIXELES * bytes);
+            separarCanales(intercalado, {rojo, verde, azul}, bytes);
+            // El primer componente verde, en orden de memoria (byte bajo primero)
+            EXPECT_EQ(verde[0], intercalado[(2 * bytes) - 1]);
+
+            std::vector<uint8_t> vuelta(intercalado.size());
+            intercalarCanales({rojo, verde, azul}, vuelta, bytes);
+            EXPECT_EQ(vuelta, intercalado);
+        });
+    }
+}
+
+TEST(NucleosTest, NarrowsIndicesLowByteFirst) {
+    std::vector<uint32_t> indices(PIXELES);
+    for (std::size_t i = 0; i < PIXELES; ++i) {
+        indices[i] = static_cast<uint32_t>(i) * PASO_INDICE;
+    }
+    for (const std::size_t bytes : {std::size_t{1}, std::size_t{2}, BYTES_INDICE}) {
+        conCadaNivel([&] {
+            std::vector<uint8_t> destino(PIXELES * bytes);
+            estrecharIndices(indices, destino, bytes);
+            for (std::size_t i = 0; i < PIXELES; ++i) {
+                uint32_t valor = 0;
+                for (std::size_t byte = 0; byte < bytes; ++byte) {
+                    valor |= static_cast<uint32_t>(destino[(i * bytes) + byte]) << (byte * BITS_BYTE);
+                }
+                const uint32_t mascara = (bytes == BYTES_INDICE) ? ~uint32_t{0} : ((uint32_t{1} << (bytes * BITS_BYTE)) - 1);
+                ASSERT_EQ(valor, indices[i] & mascara);
+            }
+        });
+    }
+}
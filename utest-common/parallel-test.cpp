@@ -0,0 +1,97 @@
+// File: utest-common/parallel-test.cpp
+#include "../common/parallel.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+  constexpr std::size_t RANGE_BEGIN = 3;
+  constexpr std::size_t RANGE_END = 1003;
+  constexpr std::size_t GRAIN = 7;
+  constexpr std::size_t OUTER = 16;
+  constexpr std::size_t INNER = 64;
+  constexpr std::size_t TASKS = 100;
+  constexpr std::size_t ROWS = 1000;
+  constexpr std::size_t ROW_WORK = 1U << 16U;
+}
+
+TEST(ParallelTest, ParallelForVisitsEveryIndexOnce) {
+    std::vector<std::atomic<int>> visits(RANGE_END);
+    std::atomic<std::size_t> largestChunk{0};
+    parallelFor(RANGE_BEGIN, RANGE_END, GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+        largestChunk = std::max(largestChunk.load(), end - begin);
+    });
+    for (std::size_t i = 0; i < RANGE_END; ++i) {
+        EXPECT_EQ(visits[i].load(), (i >= RANGE_BEGIN) ? 1 : 0) << "índice " << i;
+    }
+    EXPECT_LE(largestChunk.load(), GRAIN);
+}
+
+TEST(ParallelTest, ParallelForWithAutomaticGrainCoversRange) {
+    std::atomic<std::size_t> total{0};
+    parallelFor(0, RANGE_END, 0, [&](std::size_t begin, std::size_t end) { total += end - begin; });
+    EXPECT_EQ(total.load(), RANGE_END);
+
+    // Un rango vacío no llama a la función
+    parallelFor(RANGE_END, RANGE_END, 0, [&](std::size_t, std::size_t) { total = 0; });
+    EXPECT_EQ(total.load(), RANGE_END);
+}
+
+// Los bucles anidados no bloquean el grupo: quien espera ejecuta tareas pendientes
+TEST(ParallelTest, NestedParallelForCompletes) {
+    std::atomic<std::size_t> total{0};
+    parallelFor(0, OUTER, 1, [&](std::size_t outerBegin, std::size_t outerEnd) {
+        for (std::size_t i = outerBegin; i < outerEnd; ++i) {
+            parallelFor(0, INNER, 1, [&](std::size_t begin, std::size_t end) { total += end - begin; });
+        }
+    });
+    EXPECT_EQ(total.load(), OUTER * INNER);
+}
+
+TEST(ParallelTest, TaskGroupRunsEveryTask) {
+    std::atomic<std::size_t> sum{0};
+    TaskGroup group;
+    for (std::size_t i = 1; i <= TASKS; ++i) {
+        group.run([&sum, i] { sum += i; });
+    }
+    group.wait();
+    EXPECT_EQ(sum.load(), TASKS * (TASKS + 1) / 2);
+}
+
+TEST(ParallelTest, TaskGroupRethrowsTaskException) {
+    std::atomic<std::size_t> finished{0};
+    TaskGroup group;
+    group.run([] { throw std::runtime_error("fallo en tarea"); });
+    for (std::size_t i = 0; i < TASKS; ++i) {
+        group.run([&finished] { ++finished; });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    // El resto de tareas termina igualmente
+    EXPECT_EQ(finished.load(), TASKS);
+}
+
+TEST(ParallelTest, ParallelForRowsUsesContiguousStripes) {
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, std::size_t>> stripes;
+    parallelForRows(ROWS, ROW_WORK, [&](std::size_t begin, std::size_t end) {
+        const std::lock_guard lock{mutex};
+        stripes.emplace_back(begin, end);
+    });
+    std::ranges::sort(stripes);
+    ASSERT_FALSE(stripes.empty());
+    EXPECT_LE(stripes.size(), threadCount());
+    std::size_t next = 0;
+    for (const auto & [begin, end] : stripes) {
+        EXPECT_EQ(begin, next);
+        next = end;
+    }
+    EXPECT_EQ(next, ROWS);
+}
@@ -0,0 +1,82 @@
+// File: utest-common/planos-test.cpp
+#include "../common/planos.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+  constexpr std::size_t ANCHO = 5;
+  constexpr std::size_t ALTO = 3;
+  constexpr std::size_t ANCHO_POTENCIA_2 = 2048;
+  constexpr std::size_t PAGINA = 4096;
+  constexpr uint8_t VALOR = 0x5A;
+
+  template <typename T>
+  bool alineado(const T* puntero) {
+    return std::bit_cast<std::uintptr_t>(puntero) % ALINEACION_PLANOS == 0;
+  }
+
+  std::vector<uint8_t> secuencia(std::size_t desde) {
+    std::vector<uint8_t> datos(ANCHO * ALTO);
+    for (std::size_t i = 0; i < datos.size(); ++i) {
+      datos[i] = static_cast<uint8_t>(desde + i);
+    }
+    return datos;
+  }
+}  // namespace
+
+TEST(PlanosTest, RowsAndPlanesStartAligned) {
+    const PlanosAlineados<uint8_t> planos(ANCHO, ALTO);
+    EXPECT_EQ(planos.paso(), ALINEACION_PLANOS);
+    for (std::size_t canal = 0; canal < PlanosAlineados<uint8_t>::CANALES; ++canal) {
+      for (std::size_t y = 0; y < ALTO; ++y) {
+        EXPECT_TRUE(alineado(planos.fila(canal, y).data()));
+        EXPECT_EQ(planos.fila(canal, y).size(), ANCHO);
+      }
+    }
+}
+
+TEST(PlanosTest, PlanesShareOneAllocation) {
+    const PlanosAlineados<uint16_t> planos(ANCHO, ALTO);
+    const std::size_t entrePlanos = static_cast<std::size_t>(planos.plano(1).data() - planos.plano(0).data());
+    EXPECT_EQ(planos.plano(2).data() - planos.plano(1).data(), static_cast<std::ptrdiff_t>(entrePlanos));
+    EXPECT_GE(entrePlanos, planos.paso() * ALTO);
+}
+
+TEST(PlanosTest, PowerOfTwoStridesAreOffset) {
+    const PlanosAlineados<uint16_t> planos(ANCHO_POTENCIA_2, 2);
+    EXPECT_EQ(planos.paso() * sizeof(uint16_t), (ANCHO_POTENCIA_2 * sizeof(uint16_t)) + ALINEACION_PLANOS);
+    const GeometriaPlanos geometria = calcularGeometriaPlanos(ALINEACION_PLANOS, PAGINA / ALINEACION_PLANOS);
+    EXPECT_EQ(geometria.bytesFila, ALINEACION_PLANOS);
+    EXPECT_EQ(geometria.bytesPlano, PAGINA + ALINEACION_PLANOS);
+}
+
+TEST(PlanosTest, CompactChannelsRoundTrip) {
+    const PlanosAlineados<uint8_t> planos(ANCHO, ALTO, {secuencia(0), secuencia(ANCHO * ALTO), secuencia(2 * ANCHO * ALTO)});
+    EXPECT_EQ(planos.canal(0), secuencia(0));
+    EXPECT_EQ(planos.canal(2), secuencia(2 * ANCHO * ALTO));
+    // El relleno queda a cero
+    EXPECT_EQ(planos.plano(1)[ANCHO], 0);
+}
+
+TEST(PlanosTest, CopyIsDeep) {
+    PlanosAlineados<uint8_t> original(ANCHO, ALTO);
+    const PlanosAlineados<uint8_t> copia = original;
+    original.fila(0, 1)[2] = VALOR;
+    EXPECT_EQ(copia.fila(0, 1)[2], 0);
+    EXPECT_NE(copia.plano(0).data(), original.plano(0).data());
+    EXPECT_TRUE(alineado(copia.plano(0).data()));
+    const PlanosAlineados<uint8_t> movida = std::move(original);
+    EXPECT_EQ(movida.fila(0, 1)[2], VALOR);
+}
+
+TEST(PlanosTest, EmptyPlanesHaveNoStorage) {
+    const PlanosAlineados<uint16_t> planos;
+    EXPECT_TRUE(planos.vacio());
+    EXPECT_TRUE(planos.plano(0).empty());
+    EXPECT_TRUE(planos.canal(0).empty());
+    EXPECT_TRUE(std::ranges::all_of(bytesDe(planos.plano(1)), [](uint8_t byte) { return byte == 0; }));
+}
@@ -83,3 +83,128 @@ TEST(ProgramArgsTest, ParsesComplexAdditionalArgumentsCorrectly) {
     EXPECT_EQ(additionalParams[1], "param with spaces");
     EXPECT_EQ(additionalParams[2], "param3");
 }
+
+TEST(ProgramArgsTest, ExtractsThreadOptionAnywhere) {
+    std::vector<std::string> args = {"program", "-j", "4", "in.txt", "output.txt", "resize", "--threads=2", "10", "20"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_EQ(parsedArgs.getInputFile(), "in.txt");
+    EXPECT_EQ(parsedArgs.getOperation(), "resize");
+    EXPECT_EQ(parsedArgs.getThreadCount(), 2);
+    const auto& additionalParams = parsedArgs.getAdditionalParams();
+    ASSERT_EQ(additionalParams.size(), 2);
+    EXPECT_EQ(additionalParams[0], "10");
+    EXPECT_EQ(additionalParams[1], "20");
+}
+
+TEST(ProgramArgsTest, ThrowsExceptionOnInvalidThreadCount) {
+    std::vector<std::string> args = {"program", "in.txt", "output.txt", "resize", "-j0", "10", "20"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    EXPECT_THROW({
+        ProgramArgs const parsedArgs(argc, argv.data());
+    }, std::invalid_argument);
+}
+
+TEST(ProgramArgsTest, ExtractsPinThreadsOption) {
+    std::vector<std::string> args = {"program", "in.txt", "output.txt", "--pin-threads", "maxlevel", "100"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_TRUE(parsedArgs.getPinThreads());
+    EXPECT_EQ(parsedArgs.getOperation(), "maxlevel");
+    ASSERT_EQ(parsedArgs.getAdditionalParams().size(), 1);
+}
+
+TEST(ProgramArgsTest, ExtractsStatsOption) {
+    std::vector<std::string> args = {"program", "--stats", "in.txt", "output.txt", "maxlevel", "100"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_TRUE(parsedArgs.getStats());
+    EXPECT_TRUE(parsedArgs.getStatsFile().empty());
+    EXPECT_EQ(parsedArgs.getInputFile(), "in.txt");
+
+    args[1] = "--stats=report.json";
+    argv[1] = args[1].data();
+    ProgramArgs const withFile(argc, argv.data());
+    EXPECT_TRUE(withFile.getStats());
+    EXPECT_EQ(withFile.getStatsFile(), "report.json");
+}
+
+TEST(ProgramArgsTest, CountersOptionImpliesStats) {
+    std::vector<std::string> args = {"program", "in.txt", "output.txt", "resize", "--counters", "10", "20"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_TRUE(parsedArgs.getCounters());
+    EXPECT_TRUE(parsedArgs.getStats());
+    ASSERT_EQ(parsedArgs.getAdditionalParams().size(), 2);
+}
+
+TEST(ProgramArgsTest, ExtractsTraceOption) {
+    std::vector<std::string> args = {"program", "in.txt", "output.txt", "pyramid", "--trace=run.json"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_EQ(parsedArgs.getTraceFile(), "run.json");
+    EXPECT_FALSE(parsedArgs.getStats());
+    EXPECT_TRUE(parsedArgs.getAdditionalParams().empty());
+
+    args[4] = "--trace=";
+    argv[4] = args[4].data();
+    EXPECT_THROW({
+        ProgramArgs const emptyTrace(argc, argv.data());
+    }, std::invalid_argument);
+}
+
+TEST(ProgramArgsTest, ExtractsIsaOption) {
+    std::vector<std::string> args = {"program", "in.txt", "output.txt", "maxlevel", "--isa=baseline", "255"};
+    std::vector<char*> argv;
+    argv.reserve(args.size());
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    int const argc = static_cast<int>(argv.size());
+
+    ProgramArgs const parsedArgs(argc, argv.data());
+    EXPECT_EQ(parsedArgs.getIsaLevel(), "baseline");
+    ASSERT_EQ(parsedArgs.getAdditionalParams().size(), 1U);
+
+    args[4] = "--isa=sse9";
+    argv[4] = args[4].data();
+    EXPECT_THROW({
+        ProgramArgs const invalidIsa(argc, argv.data());
+    }, std::invalid_argument);
+}
@@ -0,0 +1,122 @@
+// File: utest-common/reserva-test.cpp
+#include "../common/reserva.hpp"
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+  constexpr std::size_t BUFER_GRANDE = std::size_t{1} << 20U;
+  constexpr std::size_t MISMA_CLASE = BUFER_GRANDE - 100;
+  constexpr std::size_t BUFER_PEQUENO = 100;
+  constexpr std::size_t BUFER_ENORME = 2 * BYTES_PAGINA_GRANDE;
+
+  // Deja la reserva vacía y con el límite por defecto al empezar y al terminar cada prueba
+  class ReservaTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      fijarLimiteReserva(LIMITE_RESERVA_POR_DEFECTO);
+      vaciarReserva();
+      activarPaginasGrandes(estadoInicial);
+    }
+
+    void TearDown() override { SetUp(); }
+
+    bool estadoInicial = leerReserva().paginasGrandes;
+  };
+}  // namespace
+
+TEST_F(ReservaTest, ReusesFreedBufferOfSameClass) {
+    std::pmr::memory_resource * const recurso = recursoReserva();
+    void * const primero = recurso->allocate(BUFER_GRANDE, ALINEACION_RESERVA);
+    EXPECT_EQ(std::bit_cast<std::uintptr_t>(primero) % ALINEACION_RESERVA, 0U);
+    recurso->deallocate(primero, BUFER_GRANDE, ALINEACION_RESERVA);
+    EXPECT_GE(leerReserva().bytesRetenidos, BUFER_GRANDE);
+
+    const LecturaReserva antes = leerReserva();
+    void * const segundo = recurso->allocate(MISMA_CLASE, ALINEACION_RESERVA);
+    EXPECT_EQ(segundo, primero);
+    EXPECT_EQ(leerReserva().reutilizados, antes.reutilizados + 1);
+    EXPECT_EQ(leerReserva().nuevos, antes.nuevos);
+    recurso->deallocate(segundo, MISMA_CLASE, ALINEACION_RESERVA);
+}
+
+TEST_F(ReservaTest, SmallBuffersBypassPool) {
+    const LecturaReserva antes = leerReserva();
+    std::pmr::memory_resource * const recurso = recursoReserva();
+    void * const bloque = recurso->allocate(BUFER_PEQUENO, alignof(std::max_align_t));
+    recurso->deallocate(bloque, BUFER_PEQUENO, alignof(std::max_align_t));
+    EXPECT_EQ(leerReserva().nuevos, antes.nuevos);
+    EXPECT_EQ(leerReserva().bytesRetenidos, 0U);
+}
+
+TEST_F(ReservaTest, ZeroLimitDisablesRecycling) {
+    fijarLimiteReserva(0);
+    std::pmr::memory_resource * const recurso = recursoReserva();
+    void * const bloque = recurso->allocate(BUFER_GRANDE, ALINEACION_RESERVA);
+    recurso->deallocate(bloque, BUFER_GRANDE, ALINEACION_RESERVA);
+    EXPECT_EQ(leerReserva().bytesRetenidos, 0U);
+}
+
+TEST_F(ReservaTest, ArenaReturnsBlocksToPool) {
+    {
+      ArenaTemporal arena;
+      std::pmr::vector<uint32_t> histograma(UMBRAL_RESERVA, &arena);
+      histograma.back() = 1;
+      EXPECT_EQ(histograma.back(), 1U);
+    }
+    EXPECT_GE(leerReserva().bytesRetenidos, UMBRAL_RESERVA);
+}
+
+TEST_F(ReservaTest, HugeBuffersAlignToHugePages) {
+    std::pmr::memory_resource * const recurso = recursoReserva();
+    activarPaginasGrandes(true);
+    const LecturaReserva antes = leerReserva();
+    void * const bloque = recurso->allocate(BUFER_ENORME, ALINEACION_RESERVA);
+    EXPECT_EQ(std::bit_cast<std::uintptr_t>(bloque) % BYTES_PAGINA_GRANDE, 0U);
+    // Según el sistema el consejo se acepta o se rechaza, pero siempre se intenta
+    const LecturaReserva despues = leerReserva();
+    EXPECT_GT(despues.bytesPaginasGrandes + despues.rechazosPaginasGrandes,
+              antes.bytesPaginasGrandes + antes.rechazosPaginasGrandes);
+    recurso->deallocate(bloque, BUFER_ENORME, ALINEACION_RESERVA);
+}
+
+TEST_F(ReservaTest, DisabledHugePagesSkipAdvice) {
+    activarPaginasGrandes(false);
+    const LecturaReserva antes = leerReserva();
+    std::pmr::memory_resource * const recurso = recursoReserva();
+    void * const bloque = recurso->allocate(BUFER_ENORME, ALINEACION_RESERVA);
+    recurso->deallocate(bloque, BUFER_ENORME, ALINEACION_RESERVA);
+    EXPECT_FALSE(leerReserva().paginasGrandes);
+    EXPECT_EQ(leerReserva().bytesPaginasGrandes, antes.bytesPaginasGrandes);
+    EXPECT_EQ(leerReserva().rechazosPaginasGrandes, antes.rechazosPaginasGrandes);
+}
+
+TEST_F(ReservaTest, PoolVectorsAndTheirCopiesRecycle) {
+    {
+      const VectorReserva<uint8_t> pixeles(BUFER_GRANDE, 1);
+      const VectorReserva<uint8_t> copia = pixeles;
+      EXPECT_EQ(copia.back(), 1);
+    }
+    EXPECT_GE(leerReserva().bytesRetenidos, 2 * BUFER_GRANDE);
+    const LecturaReserva antes = leerReserva();
+    const VectorReserva<uint8_t> otra(MISMA_CLASE);
+    EXPECT_EQ(leerReserva().reutilizados, antes.reutilizados + 1);
+    // Los búferes reciclados se vuelven a poner a cero
+    EXPECT_EQ(otra.back(), 0);
+}
+
+TEST_F(ReservaTest, HugePagesNeedAKernelMode) {
+    activarPaginasGrandes(true);
+    LecturaReserva lectura = leerReserva();
+    for (const char * modo : {"never", ""}) {
+      lectura.modoPaginasGrandes = modo;
+      EXPECT_FALSE(paginasGrandesDisponibles(lectura)) << "modo '" << modo << "'";
+    }
+    lectura.modoPaginasGrandes = "madvise";
+    EXPECT_TRUE(paginasGrandesDisponibles(lectura));
+    lectura.paginasGrandes = false;
+    EXPECT_FALSE(paginasGrandesDisponibles(lectura));
+}
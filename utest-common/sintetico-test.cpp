@@ -0,0 +1,98 @@
+// File: utest-common/sintetico-test.cpp
+#include "../common/sintetico.hpp"
+#include "../common/binario.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+  constexpr int SIDE = 64;
+  constexpr int MAX_8BIT = 255;
+  constexpr int MAX_16BIT = 65535;
+  constexpr std::size_t PALETTE_COLORS = 100;
+  constexpr double STEEP_ZIPF = 2.0;
+  constexpr int NOISE = 8;
+  constexpr uint64_t SEED = 42;
+  constexpr std::size_t REGION_SIDE = 32;
+
+  OpcionesSintetico opcionesBase(PatronSintetico patron, int maxValue) {
+    return {.atributos = {.width = SIDE, .height = SIDE, .maxValue = maxValue},
+            .patron = patron,
+            .colores = PALETTE_COLORS,
+            .zipf = 1.0,
+            .ruido = NOISE,
+            .semilla = SEED};
+  }
+
+  // Número de apariciones de cada color de una imagen de 8 bits
+  std::map<std::tuple<uint8_t, uint8_t, uint8_t>, std::size_t> histograma(const PPMImage& image) {
+    std::map<std::tuple<uint8_t, uint8_t, uint8_t>, std::size_t> cuenta;
+    for (std::size_t i = 0; i + 2 < image.pixelData.size(); i += 3) {
+      ++cuenta[{image.pixelData[i], image.pixelData[i + 1], image.pixelData[i + 2]}];
+    }
+    return cuenta;
+  }
+}
+
+TEST(SinteticoTest, SameSeedGivesSameImage) {
+    OpcionesSintetico opciones = opcionesBase(PatronSintetico::degradado, MAX_8BIT);
+    const PPMImage first = generarImagenSintetica(opciones);
+    EXPECT_EQ(first.pixelData, generarImagenSintetica(opciones).pixelData);
+    opciones.semilla = SEED + 1;
+    EXPECT_NE(first.pixelData, generarImagenSintetica(opciones).pixelData);
+}
+
+TEST(SinteticoTest, PaletteHasExactNumberOfColors) {
+    const PPMImage image = generarImagenSintetica(opcionesBase(PatronSintetico::paleta, MAX_8BIT));
+    EXPECT_EQ(histograma(image).size(), PALETTE_COLORS);
+}
+
+TEST(SinteticoTest, SteepZipfConcentratesColors) {
+    OpcionesSintetico opciones = opcionesBase(PatronSintetico::paleta, MAX_8BIT);
+    opciones.zipf = STEEP_ZIPF;
+    const auto cuenta = histograma(generarImagenSintetica(opciones));
+    const auto masFrecuente = std::ranges::max_element(cuenta, {}, [](const auto& par) { return par.second; });
+    // Con exponente 2 el primer color se lleva más de la mitad de los píxeles
+    EXPECT_GT(masFrecuente->second * 2, static_cast<std::size_t>(SIDE * SIDE));
+}
+
+TEST(SinteticoTest, RegionsAreFlatBlocks) {
+    const PPMImage image = generarImagenSintetica(opcionesBase(PatronSintetico::regiones, MAX_8BIT));
+    const auto pixel = [&image](std::size_t x, std::size_t y) {
+        const std::size_t i = ((y * SIDE) + x) * 3;
+        return std::make_tuple(image.pixelData[i], image.pixelData[i + 1], image.pixelData[i + 2]);
+    };
+    for (std::size_t y = 0; y < REGION_SIDE; ++y) {
+        for (std::size_t x = 0; x < REGION_SIDE; ++x) {
+            EXPECT_EQ(pixel(x, y), pixel(0, 0));
+        }
+    }
+}
+
+TEST(SinteticoTest, FileMatchesImageInMemory) {
+    const std::string filePath = "./test_sintetico.ppm";
+    const OpcionesSintetico opciones = opcionesBase(PatronSintetico::ruido, MAX_16BIT);
+    ASSERT_TRUE(escribirImagenSintetica(filePath, opciones));
+    PPMImage leida;
+    ASSERT_TRUE(leerImagenPPM(filePath, leida));
+    EXPECT_EQ(leida.maxValue, MAX_16BIT);
+    EXPECT_TRUE(leida.pixelData.empty());
+    EXPECT_EQ(leida.pixelData16, generarImagenSintetica(opciones).pixelData16);
+    (void)std::remove(filePath.c_str());
+}
+
+TEST(SinteticoTest, RejectsMoreColorsThanTheDepthAllows) {
+    // Con valor máximo 1 solo hay 2^3 colores distintos
+    OpcionesSintetico opciones = opcionesBase(PatronSintetico::paleta, 1);
+    opciones.colores = 8;
+    EXPECT_NO_THROW(std::ignore = generarImagenSintetica(opciones));
+    opciones.colores = 9;
+    EXPECT_THROW(std::ignore = generarImagenSintetica(opciones), std::invalid_argument);
+    EXPECT_THROW(std::ignore = leerPatronSintetico("stripes"), std::invalid_argument);
+}
@@ -0,0 +1,51 @@
+// File: utest-common/traza-test.cpp
+#include "../common/traza.hpp"
+#include "../common/parallel.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+  constexpr std::size_t ELEMENTS = 100;
+  constexpr std::size_t GRAIN = 10;
+
+  std::string leerArchivo(const std::string& filePath) {
+    const std::ifstream file(filePath);
+    std::stringstream contenido;
+    contenido << file.rdbuf();
+    return contenido.str();
+  }
+
+  std::size_t contar(const std::string& texto, const std::string& patron) {
+    std::size_t veces = 0;
+    for (std::size_t pos = texto.find(patron); pos != std::string::npos; pos = texto.find(patron, pos + 1)) {
+      ++veces;
+    }
+    return veces;
+  }
+}
+
+TEST(TrazaTest, WritesChromeTraceEvents) {
+    const std::string filePath = "./test_trace.json";
+    activarTraza(filePath);
+    ASSERT_TRUE(trazaActiva());
+    nombrarHiloTraza("main");
+    {
+        const EventoTraza evento{"resize"};
+        parallelFor(0, ELEMENTS, GRAIN, [](std::size_t, std::size_t) {});
+    }
+    ASSERT_TRUE(escribirTraza());
+
+    const std::string trace = leerArchivo(filePath);
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [", 0), 0);
+    EXPECT_NE(trace.find("\"args\": {\"name\": \"main\"}"), std::string::npos);
+    EXPECT_EQ(contar(trace, "{\"name\": \"resize\", \"ph\": \"X\""), 1);
+    // Un evento por bloque, con su rango de índices, sea cual sea el hilo que lo procesó
+    EXPECT_EQ(contar(trace, "{\"name\": \"chunk\", \"ph\": \"X\""), ELEMENTS / GRAIN);
+    EXPECT_NE(trace.find("\"args\": {\"begin\": 0, \"end\": 10}"), std::string::npos);
+    EXPECT_NE(trace.find("\"args\": {\"begin\": 90, \"end\": 100}"), std::string::npos);
+    (void)std::remove(filePath.c_str());
+}
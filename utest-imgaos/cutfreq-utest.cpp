@@ -62,14 +62,21 @@ TEST_F(CutFreqTest, ThrowsOnInvalidNumberOfColorsToCut) {
     );
 }
 
-// Verifica que la función lanza una excepción cuando se intenta eliminar más colores de los que existen en la imagen
-TEST_F(CutFreqTest, ThrowsOnExcessiveNumberOfColorsToCut) {
-    ASSERT_TRUE(writeTestImageToDisk());
-
-    EXPECT_THROW(
-        cutfreq(getTestImage(), 100),
-        std::invalid_argument
+// Verifica que eliminar más colores de los que existen no es un error (igual que en SOA):
+// se conserva el color más frecuente, que con todos empatados es el de menor azul, verde
+// y rojo (el rojo puro), y toda la imagen queda de ese color
+TEST_F(CutFreqTest, AcceptsExcessiveNumberOfColorsToCut) {
+    PPMImage image = getTestImage();
+    ASSERT_NO_THROW(
+        cutfreq(image, 100)
     );
+
+    ASSERT_EQ(image.pixelData.size(), getTestImage().pixelData.size());
+    for (std::size_t i = 0; i < image.pixelData.size(); i += 3) {
+        EXPECT_EQ(image.pixelData[i], COLOR_RED);
+        EXPECT_EQ(image.pixelData[i + 1], 0);
+        EXPECT_EQ(image.pixelData[i + 2], 0);
+    }
 }
 
 // Verifica el comportamiento con una imagen vacía
@@ -175,9 +182,10 @@ TEST_F(CutFreqTest, RemoveAllColors) {
         cutfreq(image, static_cast<int>(image.pixelData.size() / 3))
     );
 
-    // Verifica que todos los colores hayan sido reemplazados por el valor predeterminado (negro en este caso)
+    // Verifica que todos los colores hayan sido reemplazados por el único que se conserva,
+    // el más frecuente (con todos empatados, el rojo puro)
     for (std::size_t i = 0; i < image.pixelData.size(); i += 3) {
-        EXPECT_EQ(image.pixelData[i], 0);
+        EXPECT_EQ(image.pixelData[i], COLOR_RED);
         EXPECT_EQ(image.pixelData[i + 1], 0);
         EXPECT_EQ(image.pixelData[i + 2], 0);
     }
@@ -12,7 +12,6 @@ constexpr unsigned int MAX_8BIT = 255U;
 constexpr unsigned int MAX_16BIT = 65535U;
 constexpr unsigned int HALF_8BIT = 127U;
 constexpr unsigned int BITS_PER_BYTE = 8U;
-constexpr unsigned int BYTE_MASK = 0xFFU;
 constexpr unsigned int TEST_WIDTH = 2U;
 constexpr unsigned int TEST_HEIGHT = 2U;
 constexpr unsigned int ARBITRARY_MAX = 100U;
@@ -92,7 +91,7 @@ TEST_F(MaxLevelTest, ConvertTo8BitMax) {
     EXPECT_EQ(result.width, getTestImage().width);
     EXPECT_EQ(result.height, getTestImage().height);
 
-    const std::vector<unsigned char> expectedValues = {
+    const VectorReserva<unsigned char> expectedValues = {
         HALF_8BIT, 0, 0,
         0, HALF_8BIT, 0,
         0, 0, HALF_8BIT,
@@ -103,7 +102,7 @@ TEST_F(MaxLevelTest, ConvertTo8BitMax) {
 }
 
 // Verifica la conversión correcta de una imagen de 8 bits a 16 bits
-// Comprueba que el tamaño de los datos se duplica y los valores se escalan correctamente
+// Comprueba que los componentes pasan al almacenamiento de 16 bits
 TEST_F(MaxLevelTest, ConvertTo16BitMax) {
     ASSERT_TRUE(writeTestImageToDisk());
 
@@ -117,7 +116,8 @@ TEST_F(MaxLevelTest, ConvertTo16BitMax) {
     EXPECT_EQ(result.maxValue, static_cast<int>(MAX_16BIT));
     EXPECT_EQ(result.width, getTestImage().width);
     EXPECT_EQ(result.height, getTestImage().height);
-    EXPECT_EQ(result.pixelData.size(), getTestImage().pixelData.size() * 2);
+    EXPECT_TRUE(result.pixelData.empty());
+    EXPECT_EQ(result.pixelData16.size(), getTestImage().pixelData.size());
 }
 
 // Verifica el manejo correcto de imágenes vacías (0x0 píxeles)
@@ -154,15 +154,10 @@ TEST_F(MaxLevelTest, ThrowsOnNonexistentInputFile) {
 TEST_F(MaxLevelTest, From16BitTo8Bit) {
     PPMImage img16bit = getTestImage();
     img16bit.maxValue = static_cast<int>(MAX_16BIT);
-    std::vector<unsigned char> data16Bit;
-
     for (const auto& value : img16bit.pixelData) {
-        auto scaledValue = static_cast<unsigned short>(value << BITS_PER_BYTE);
-        data16Bit.push_back(static_cast<unsigned char>(scaledValue & BYTE_MASK));
-        data16Bit.push_back(static_cast<unsigned char>(scaledValue >> BITS_PER_BYTE));
+        img16bit.pixelData16.push_back(static_cast<uint16_t>(value << BITS_PER_BYTE));
     }
-
-    img16bit.pixelData = data16Bit;
+    img16bit.pixelData.clear();
     setTestImage(img16bit);
     ASSERT_TRUE(writeTestImageToDisk());
 
@@ -173,7 +168,7 @@ TEST_F(MaxLevelTest, From16BitTo8Bit) {
     PPMImage result;
     ASSERT_TRUE(leerImagenPPM(getOutputPath(), result));
     EXPECT_EQ(result.maxValue, static_cast<int>(MAX_8BIT));
-    EXPECT_EQ(result.pixelData.size(), getTestImage().pixelData.size() / 2);
+    EXPECT_EQ(result.pixelData.size(), getTestImage().pixelData16.size());
 }
 
 // Verifica el comportamiento del redondeo al convertir valores de píxeles
@@ -204,7 +199,7 @@ TEST_F(MaxLevelTest, ConvertToQuarter8Bit) {
 
     EXPECT_EQ(result.maxValue, static_cast<int>(QUARTER_8BIT));
 
-    const std::vector<unsigned char> expectedValues = {
+    const VectorReserva<unsigned char> expectedValues = {
         QUARTER_8BIT, 0, 0,
         0, QUARTER_8BIT, 0,
         0, 0, QUARTER_8BIT,
@@ -283,7 +278,7 @@ TEST_F(MaxLevelTest, PreserveBlackPixels) {
     blackImage.width = 2;
     blackImage.height = 2;
     blackImage.maxValue = static_cast<int>(MAX_8BIT);
-    blackImage.pixelData = std::vector<unsigned char>(BLACK, 0);  // 4 píxeles negros
+    blackImage.pixelData = VectorReserva<unsigned char>(BLACK, 0);  // 4 píxeles negros
 
     ASSERT_TRUE(escribirImagenPPM(getInputPath(), blackImage));
 
@@ -301,4 +296,35 @@ TEST_F(MaxLevelTest, PreserveBlackPixels) {
     }
 }
 
+// Verifica que applyMaxLevel escala en el propio búfer cuando la profundidad no cambia
+TEST_F(MaxLevelTest, ApplyInPlaceKeepsBuffer) {
+    PPMImage image = getTestImage();
+    const unsigned char* const data = image.pixelData.data();
+
+    applyMaxLevel(image, static_cast<int>(HALF_8BIT));
+
+    EXPECT_EQ(image.maxValue, static_cast<int>(HALF_8BIT));
+    EXPECT_EQ(image.pixelData.data(), data);
+    const VectorReserva<unsigned char> expectedValues = {
+        HALF_8BIT, 0, 0,
+        0, HALF_8BIT, 0,
+        0, 0, HALF_8BIT,
+        HALF_8BIT, HALF_8BIT, HALF_8BIT
+    };
+    EXPECT_EQ(image.pixelData, expectedValues);
+}
+
+// Verifica que applyMaxLevel amplía los datos al pasar de 8 a 16 bits
+TEST_F(MaxLevelTest, ApplyTo16BitWidensData) {
+    PPMImage image = getTestImage();
+
+    applyMaxLevel(image, static_cast<int>(MAX_16BIT));
+
+    EXPECT_EQ(image.maxValue, static_cast<int>(MAX_16BIT));
+    EXPECT_TRUE(image.pixelData.empty());
+    ASSERT_EQ(image.pixelData16.size(), getTestImage().pixelData.size());
+    EXPECT_EQ(image.pixelData16[0], MAX_16BIT);
+    EXPECT_EQ(image.pixelData16[1], 0);
+}
+
 }  // namespace
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include "../imgaos/resize.hpp"
 #include "../common/binario.hpp"
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
+#include <filesystem>
 #include <fstream>  // Para la definición de std::ofstream
 
 // Definición de constantes para evitar el uso de números mágicos
@@ -31,7 +33,7 @@ protected:
       image.width = params.width;
       image.height = params.height;
       image.maxValue = params.maxValue;
-      image.pixelData = data;
+      image.pixelData.assign(data.begin(), data.end());
       return image;
     }
     // Función de ayuda para crear una imagen de prueba predeterminada
@@ -162,6 +164,22 @@ TEST_F(ResizeTest, InvalidPPMFormat) {
     }, std::runtime_error);
 }
 
+// Verificar que una entrada con el cuerpo truncado se rechaza antes de crear la salida,
+// en lugar de dejar un archivo a medio escribir
+TEST_F(ResizeTest, TruncatedInputLeavesNoOutput) {
+    std::ofstream outFile("truncated.ppm", std::ios::binary);
+    outFile << "P6\n2 2\n255\n";
+    outFile.put(static_cast<char>(MAX_PIXEL_VALUE)).put(0).put(0).put(0).put(0);  // 5 de 12 bytes
+    outFile.close();
+    std::filesystem::remove("output_truncated.ppm");
+
+    EXPECT_THROW({
+        performResizeOperation("truncated.ppm", "output_truncated.ppm", 1, 1);
+    }, std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists("output_truncated.ppm"));
+    std::filesystem::remove("truncated.ppm");
+}
+
 // TESTS DE ESCENARIOS GRANDES
 // Redimensionar una imagen grande a un tamaño pequeño
 TEST_F(ResizeTest, ResizeLargeImageToSmall) {
@@ -210,3 +228,89 @@ TEST_F(ResizeTest, ResizeSmallImageToLarge) {
         EXPECT_NEAR(largeOutputImage.pixelData[i + 2], 128, 1);   // Azul
     }
 }
+
+// Redimensionar una imagen de 16 bits interpola componentes completos y conserva maxValue
+TEST_F(ResizeTest, Resize16BitImageKeepsDepth) {
+    constexpr int MAX_16BIT = 65535;
+    // Componentes en memoria como palabras nativas de 16 bits
+    PPMImage inputImage({.width=2, .height=1, .maxValue=MAX_16BIT});
+    inputImage.pixelData16 = {1000, 20000, MAX_16BIT, 3000, 40000, MAX_16BIT};
+    escribirImagenPPM("input_16bit.ppm", inputImage);
+
+    performResizeOperation("input_16bit.ppm", "output_16bit.ppm", 3, 1);
+    PPMImage outputImage;
+    ASSERT_TRUE(leerImagenPPM("output_16bit.ppm", outputImage));
+    EXPECT_EQ(outputImage.maxValue, MAX_16BIT);
+    ASSERT_EQ(outputImage.pixelData16.size(), 3U * 3U);
+
+    // El píxel central es la media exacta de los dos originales
+    const std::vector<int> expectedMiddle = {2000, 30000, MAX_16BIT};
+    for (std::size_t c = 0; c < expectedMiddle.size(); ++c) {
+        EXPECT_EQ(outputImage.pixelData16[3 + c], expectedMiddle[c]);
+    }
+}
+
+// El filtro de área promedia cada bloque de 2x2 y el de vecino copia un píxel original
+TEST_F(ResizeTest, AreaAndNearestFilters) {
+    const PPMImage inputImage = createTestImage({.width=2, .height=2, .maxValue=MAX_PIXEL_VALUE}, {
+        0, CONST_10, MAX_PIXEL_VALUE,   CONST_128, CONST_10, MAX_PIXEL_VALUE,
+        CONST_128, CONST_50, 0,         MAX_PIXEL_VALUE, CONST_50, 0
+    });
+    escribirImagenPPM("input_2x2.ppm", inputImage);
+
+    performResizeOperation("input_2x2.ppm", "output_area.ppm",
+                           {.width = 1, .height = 1, .filtro = FiltroEscalado::area});
+    PPMImage areaImage;
+    ASSERT_TRUE(leerImagenPPM("output_area.ppm", areaImage));
+    const VectorReserva<unsigned char> expectedArea = {128, 30, 128};
+    EXPECT_EQ(areaImage.pixelData, expectedArea);
+
+    performResizeOperation("input_2x2.ppm", "output_nearest.ppm",
+                           {.width = 1, .height = 1, .filtro = FiltroEscalado::vecino});
+    PPMImage nearestImage;
+    ASSERT_TRUE(leerImagenPPM("output_nearest.ppm", nearestImage));
+    const VectorReserva<unsigned char> expectedNearest = {MAX_PIXEL_VALUE, CONST_50, 0};
+    EXPECT_EQ(nearestImage.pixelData, expectedNearest);
+}
+
+// Una imagen más alta que la ventana de filas de origen se escala fila a fila igual
+// que una pequeña: cada fila de salida copia su fila original más cercana
+TEST_F(ResizeTest, StreamsImageTallerThanRowWindow) {
+    constexpr int width = 1000;
+    constexpr int height = 2000;
+    std::vector<unsigned char> data(static_cast<std::size_t>(width) * height * 3);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned char>((i / (static_cast<std::size_t>(width) * 3)) % MAX_PIXEL_VALUE);
+    }
+    escribirImagenPPM("input_tall.ppm", createTestImage({.width=width, .height=height, .maxValue=MAX_PIXEL_VALUE}, data));
+
+    performResizeOperation("input_tall.ppm", "output_tall.ppm",
+                           {.width = width / 2, .height = height / 2, .filtro = FiltroEscalado::vecino});
+    PPMImage outputImage;
+    ASSERT_TRUE(leerImagenPPM("output_tall.ppm", outputImage));
+    ASSERT_EQ(outputImage.height, height / 2);
+    for (std::size_t y = 0; y < static_cast<std::size_t>(outputImage.height); ++y) {
+        const std::size_t index = y * static_cast<std::size_t>(outputImage.width) * 3;
+        ASSERT_EQ(outputImage.pixelData[index], ((2 * y) + 1) % MAX_PIXEL_VALUE) << "fila " << y;
+    }
+}
+
+// Al reducir a la cuarta parte o menos, el bilineal parte de una imagen intermedia en
+// la que cada bloque de 2x2 ya está promediado, en lugar de tomar un píxel suelto
+TEST_F(ResizeTest, BilinearLargeDownscalePreAveragesBlocks) {
+    constexpr int size = 8;
+    std::vector<unsigned char> data(static_cast<std::size_t>(size) * size * 3, CONST_128);
+    const std::vector<unsigned char> topLeftBlock = {0, CONST_10, CONST_50, MAX_PIXEL_VALUE};
+    for (std::size_t i = 0; i < topLeftBlock.size(); ++i) {
+        const std::size_t pixel = ((i / 2) * size) + (i % 2);
+        std::fill_n(data.begin() + static_cast<std::ptrdiff_t>(pixel * 3), 3, topLeftBlock[i]);
+    }
+    escribirImagenPPM("input_blocks.ppm", createTestImage({.width=size, .height=size, .maxValue=MAX_PIXEL_VALUE}, data));
+
+    performResizeOperation("input_blocks.ppm", "output_blocks.ppm", 2, 2);
+    PPMImage outputImage;
+    ASSERT_TRUE(leerImagenPPM("output_blocks.ppm", outputImage));
+    // (0 + 10 + 50 + 255 + 2) / 4
+    EXPECT_EQ(outputImage.pixelData[0], 79);
+    EXPECT_EQ(outputImage.pixelData[3], CONST_128);
+}
@@ -1,4 +1,6 @@
 #include "../imgsoa/cutfreq.hpp"
+#include "../common/planos.hpp"
+#include <cstddef>
 #include <gtest/gtest.h>
 #include <unordered_map>
 #include <vector>
@@ -20,6 +22,7 @@ namespace {
     constexpr uint8_t COLOR_ALT7 = 90;
     constexpr int LARGE_N = 1000;
     constexpr int REMOVE_MORE = 10;
+    constexpr std::size_t IMAGE_SIDE = 3;
 }
 
 // Fixture de prueba para la función cutfreq
@@ -30,12 +33,23 @@ private:
 protected:
     void SetUp() override {
         // Configurar una imagen simple de 3x3 para pruebas
-        image.redChannel = {COLOR_MAX, COLOR_MID, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MIN, COLOR_MID, COLOR_MID, COLOR_MIN};
-        image.greenChannel = {COLOR_MIN, COLOR_MID, COLOR_MAX, COLOR_MAX, COLOR_MID, COLOR_MIN, COLOR_MID, COLOR_MAX, COLOR_MIN};
-        image.blueChannel = {COLOR_MIN, COLOR_MIN, COLOR_MID, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN, COLOR_MID, COLOR_MAX};
+        setChannels({COLOR_MAX, COLOR_MID, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MIN, COLOR_MID, COLOR_MID, COLOR_MIN},
+                    {COLOR_MIN, COLOR_MID, COLOR_MAX, COLOR_MAX, COLOR_MID, COLOR_MIN, COLOR_MID, COLOR_MAX, COLOR_MIN},
+                    {COLOR_MIN, COLOR_MIN, COLOR_MID, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN, COLOR_MID, COLOR_MAX});
     }
 
     PPMImageSoA& getImage() { return image; }
+
+    // Sustituye los planos por los de una imagen de 3x3 con los canales dados
+    void setChannels(const std::vector<uint8_t>& red, const std::vector<uint8_t>& green,
+                     const std::vector<uint8_t>& blue) {
+        image.width = IMAGE_SIDE;
+        image.height = IMAGE_SIDE;
+        image.planos = PlanosAlineados<uint8_t>(IMAGE_SIDE, IMAGE_SIDE, {red, green, blue});
+    }
+
+    // Copia compacta de un canal (0 rojo, 1 verde, 2 azul)
+    [[nodiscard]] std::vector<uint8_t> channel(std::size_t index) const { return image.planos.canal(index); }
 };
 
 // Caso de prueba 1: Cálculo básico de frecuencia y reemplazo de colores
@@ -45,8 +59,8 @@ TEST_F(CutFreqTest, BasicFrequencyAndReplacement) {
 
     // Verificar que se haya realizado un reemplazo en la imagen
     bool replaced = false;
-    for (std::size_t i = 0; i < getImage().redChannel.size(); ++i) {
-        if (getImage().redChannel[i] != COLOR_MAX || getImage().greenChannel[i] != COLOR_MIN || getImage().blueChannel[i] != COLOR_MIN) {
+    for (std::size_t i = 0; i < channel(0).size(); ++i) {
+        if (channel(0)[i] != COLOR_MAX || channel(1)[i] != COLOR_MIN || channel(2)[i] != COLOR_MIN) {
             replaced = true;
             break;
         }
@@ -61,10 +75,10 @@ TEST_F(CutFreqTest, RemoveMultipleColors) {
 
     // Verificar que se hayan reemplazado los dos colores menos frecuentes
     std::unordered_map<uint32_t, int> colorFrequency;
-    for (std::size_t i = 0; i < getImage().redChannel.size(); ++i) {
-        const uint32_t color = (static_cast<uint32_t>(getImage().redChannel[i]) << SHIFT_RED) |
-                               (static_cast<uint32_t>(getImage().greenChannel[i]) << SHIFT_GREEN) |
-                               static_cast<uint32_t>(getImage().blueChannel[i]);
+    for (std::size_t i = 0; i < channel(0).size(); ++i) {
+        const uint32_t color = (static_cast<uint32_t>(channel(0)[i]) << SHIFT_RED) |
+                               (static_cast<uint32_t>(channel(1)[i]) << SHIFT_GREEN) |
+                               static_cast<uint32_t>(channel(2)[i]);
         colorFrequency[color]++;
     }
     EXPECT_LE(colorFrequency.size(), 7);
@@ -76,26 +90,26 @@ TEST_F(CutFreqTest, RemoveMoreColorsThanAvailable) {
     cutfreq(getImage(), REMOVE_MORE);
 
     // Verificar que todos los colores aún estén presentes (sin bloqueos ni comportamiento indefinido)
-    EXPECT_EQ(getImage().redChannel.size(), 9);
-    EXPECT_EQ(getImage().greenChannel.size(), 9);
-    EXPECT_EQ(getImage().blueChannel.size(), 9);
+    EXPECT_EQ(channel(0).size(), 9);
+    EXPECT_EQ(channel(1).size(), 9);
+    EXPECT_EQ(channel(2).size(), 9);
 }
 
 // Caso de prueba 4: Imagen con todos los colores idénticos
 TEST_F(CutFreqTest, AllIdenticalColors) {
     // Configurar una imagen donde todos los píxeles son del mismo color
-    getImage().redChannel = {COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID};
-    getImage().greenChannel = {COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID};
-    getImage().blueChannel = {COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID};
+    setChannels({COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID},
+                {COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID},
+                {COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID, COLOR_MID});
 
     // Eliminar el color menos frecuente (n = 1)
     cutfreq(getImage(), 1);
 
     // Dado que todos los colores son idénticos, no debería haber cambios
-    for (std::size_t i = 0; i < getImage().redChannel.size(); ++i) {
-        EXPECT_EQ(getImage().redChannel[i], COLOR_MID);
-        EXPECT_EQ(getImage().greenChannel[i], COLOR_MID);
-        EXPECT_EQ(getImage().blueChannel[i], COLOR_MID);
+    for (std::size_t i = 0; i < channel(0).size(); ++i) {
+        EXPECT_EQ(channel(0)[i], COLOR_MID);
+        EXPECT_EQ(channel(1)[i], COLOR_MID);
+        EXPECT_EQ(channel(2)[i], COLOR_MID);
     }
 }
 
@@ -105,25 +119,25 @@ TEST_F(CutFreqTest, NoColorsToReplace) {
     cutfreq(getImage(), 0);
 
     // Verificar que todos los colores siguen siendo los mismos que en el original
-    EXPECT_EQ(getImage().redChannel[0], COLOR_MAX);
-    EXPECT_EQ(getImage().greenChannel[0], COLOR_MIN);
-    EXPECT_EQ(getImage().blueChannel[0], COLOR_MIN);
+    EXPECT_EQ(channel(0)[0], COLOR_MAX);
+    EXPECT_EQ(channel(1)[0], COLOR_MIN);
+    EXPECT_EQ(channel(2)[0], COLOR_MIN);
 }
 
 // Caso de prueba 6: Imagen con colores alternantes
 TEST_F(CutFreqTest, AlternatingColors) {
     // Configurar una imagen con colores alternantes
-    getImage().redChannel = {COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX};
-    getImage().greenChannel = {COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN};
-    getImage().blueChannel = {COLOR_MIN, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN};
+    setChannels({COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX},
+                {COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN, COLOR_MAX, COLOR_MIN},
+                {COLOR_MIN, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN, COLOR_MIN, COLOR_MAX, COLOR_MAX, COLOR_MIN});
 
     // Eliminar el color menos frecuente (n = 1)
     cutfreq(getImage(), 1);
 
     // Verificar que se haya reemplazado al menos uno de los colores alternantes
     bool replaced = false;
-    for (std::size_t i = 0; i < getImage().redChannel.size(); ++i) {
-        if (getImage().redChannel[i] != COLOR_MAX || getImage().greenChannel[i] != COLOR_MIN || getImage().blueChannel[i] != COLOR_MIN) {
+    for (std::size_t i = 0; i < channel(0).size(); ++i) {
+        if (channel(0)[i] != COLOR_MAX || channel(1)[i] != COLOR_MIN || channel(2)[i] != COLOR_MIN) {
             replaced = true;
             break;
         }
@@ -134,18 +148,18 @@ TEST_F(CutFreqTest, AlternatingColors) {
 // Caso de prueba 7: Imagen con solo un color único
 TEST_F(CutFreqTest, SingleUniqueColor) {
     // Configurar una imagen con solo un color único
-    getImage().redChannel = {COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW};
-    getImage().greenChannel = {COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER};
-    getImage().blueChannel = {COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH};
+    setChannels({COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW, COLOR_LOW},
+                {COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER, COLOR_OTHER},
+                {COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH, COLOR_HIGH});
 
     // Eliminar el color menos frecuente (n = 1)
     cutfreq(getImage(), 1);
 
     // Dado que solo hay un color único, no debería haber cambios
-    for (std::size_t i = 0; i < getImage().redChannel.size(); ++i) {
-        EXPECT_EQ(getImage().redChannel[i], COLOR_LOW);
-        EXPECT_EQ(getImage().greenChannel[i], COLOR_OTHER);
-        EXPECT_EQ(getImage().blueChannel[i], COLOR_HIGH);
+    for (std::size_t i = 0; i < channel(0).size(); ++i) {
+        EXPECT_EQ(channel(0)[i], COLOR_LOW);
+        EXPECT_EQ(channel(1)[i], COLOR_OTHER);
+        EXPECT_EQ(channel(2)[i], COLOR_HIGH);
     }
 }
 
@@ -155,14 +169,15 @@ TEST_F(CutFreqTest, LargeNValue) {
     cutfreq(getImage(), LARGE_N);
 
     // Verificar que todos los colores aún estén presentes (sin bloqueos ni comportamiento indefinido)
-    EXPECT_EQ(getImage().redChannel.size(), 9);
-    EXPECT_EQ(getImage().greenChannel.size(), 9);
-    EXPECT_EQ(getImage().blueChannel.size(), 9);
+    EXPECT_EQ(channel(0).size(), 9);
+    EXPECT_EQ(channel(1).size(), 9);
+    EXPECT_EQ(channel(2).size(), 9);
 }
 
 // Caso de prueba 9: Imagen con colores aleatorios
 TEST_F(CutFreqTest, RandomColors) {
     // Configurar una imagen con colores aleatorios
-    getImage().redChannel = {COLOR_ALT1, COLOR_MAX, COLOR_MID, COLOR_ALT2, COLOR_ALT4, COLOR_ALT3, COLOR_OTHER, COLOR_HIGH, COLOR_MIN};
-    getImage().greenChannel = {COLOR_HIGH, COLOR_ALT7, COLOR_ALT6, COLOR_ALT3, COLOR_MAX};
+    setChannels({COLOR_ALT1, COLOR_MAX, COLOR_MID, COLOR_ALT2, COLOR_ALT4, COLOR_ALT3, COLOR_OTHER, COLOR_HIGH, COLOR_MIN},
+                {COLOR_HIGH, COLOR_ALT7, COLOR_ALT6, COLOR_ALT3, COLOR_MAX, COLOR_MIN, COLOR_MIN, COLOR_MIN, COLOR_MIN},
+                channel(2));
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include "../imgsoa/maxlevel.hpp"
 #include "../common/binario.hpp"
+#include "../common/planos.hpp"
 #include <vector>
 #include <stdexcept>
 #include <cstring>
@@ -14,7 +15,6 @@ constexpr unsigned int MAX_8BIT = 255U;
 constexpr unsigned int MAX_16BIT = 65535U;
 constexpr unsigned int HALF_8BIT = 127U;
 constexpr unsigned int BITS_PER_BYTE = 8U;
-constexpr unsigned int BYTE_MASK = 0xFFU;
 constexpr unsigned int TEST_WIDTH = 2U;
 constexpr unsigned int TEST_HEIGHT = 2U;
 constexpr unsigned int ARBITRARY_MAX = 100U;
@@ -35,15 +35,11 @@ protected:
         testImage.maxValue = MAX_8BIT;
 
         // 4 píxeles RGB (rojo, verde, azul, blanco)
-        testImage.redChannel = {
-            MAX_8BIT, 0, 0, MAX_8BIT  // Rojo, Verde, Azul, Blanco
-        };
-        testImage.greenChannel = {
-            0, MAX_8BIT, 0, MAX_8BIT  // Rojo, Verde, Azul, Blanco
-        };
-        testImage.blueChannel = {
-            0, 0, MAX_8BIT, MAX_8BIT  // Rojo, Verde, Azul, Blanco
-        };
+        testImage.planos = PlanosAlineados<uint8_t>(TEST_WIDTH, TEST_HEIGHT, {
+            std::vector<uint8_t>{MAX_8BIT, 0, 0, MAX_8BIT},  // Rojo, Verde, Azul, Blanco
+            std::vector<uint8_t>{0, MAX_8BIT, 0, MAX_8BIT},
+            std::vector<uint8_t>{0, 0, MAX_8BIT, MAX_8BIT}
+        });
     }
 
     void TearDown() override {
@@ -115,9 +111,9 @@ TEST_F(MaxLevelSoATest, ConvertTo8BitMax) {
         0, 0, HALF_8BIT, HALF_8BIT
     };
 
-    EXPECT_EQ(result.redChannel, expectedRed);
-    EXPECT_EQ(result.greenChannel, expectedGreen);
-    EXPECT_EQ(result.blueChannel, expectedBlue);
+    EXPECT_EQ(result.planos.canal(0), expectedRed);
+    EXPECT_EQ(result.planos.canal(1), expectedGreen);
+    EXPECT_EQ(result.planos.canal(2), expectedBlue);
 }
 
 // Test de conversión a un cuarto del valor máximo de 8 bits
@@ -145,9 +141,9 @@ TEST_F(MaxLevelSoATest, ConvertToQuarter8Bit) {
         0, 0, QUARTER_8BIT, QUARTER_8BIT
     };
 
-    EXPECT_EQ(result.redChannel, expectedRed);
-    EXPECT_EQ(result.greenChannel, expectedGreen);
-    EXPECT_EQ(result.blueChannel, expectedBlue);
+    EXPECT_EQ(result.planos.canal(0), expectedRed);
+    EXPECT_EQ(result.planos.canal(1), expectedGreen);
+    EXPECT_EQ(result.planos.canal(2), expectedBlue);
 }
 
 // Test de conversión de 8 bits a 16 bits
@@ -167,10 +163,11 @@ TEST_F(MaxLevelSoATest, ConvertTo16BitMax) {
     EXPECT_EQ(result.width, getTestImage().width);
     EXPECT_EQ(result.height, getTestImage().height);
 
-    // Verificar que los canales tienen el doble de bytes (formato 16 bits)
-    EXPECT_EQ(result.redChannel.size(), getTestImage().redChannel.size() * 2);
-    EXPECT_EQ(result.greenChannel.size(), getTestImage().greenChannel.size() * 2);
-    EXPECT_EQ(result.blueChannel.size(), getTestImage().blueChannel.size() * 2);
+    // Verificar que los canales pasan al almacenamiento de 16 bits
+    EXPECT_TRUE(result.planos.vacio());
+    EXPECT_EQ(result.planos16.canal(0).size(), getTestImage().planos.canal(0).size());
+    EXPECT_EQ(result.planos16.canal(1).size(), getTestImage().planos.canal(1).size());
+    EXPECT_EQ(result.planos16.canal(2).size(), getTestImage().planos.canal(2).size());
 }
 
 // Test de manejo de imágenes vacías
@@ -191,9 +188,7 @@ TEST_F(MaxLevelSoATest, HandleEmptyImage) {
     ASSERT_TRUE(leerImagenPPMSoA(getOutputPath(), result));
     EXPECT_EQ(result.width, 0);
     EXPECT_EQ(result.height, 0);
-    EXPECT_TRUE(result.redChannel.empty());
-    EXPECT_TRUE(result.greenChannel.empty());
-    EXPECT_TRUE(result.blueChannel.empty());
+    EXPECT_TRUE(result.planos.vacio());
 }
 
 // Test de archivo de entrada no existente
@@ -213,18 +208,19 @@ TEST_F(MaxLevelSoATest, From16BitTo8Bit) {
 
     // Convertir cada canal a formato 16 bits
     auto convertToChannel16Bit = [](const std::vector<uint8_t>& channel8bit) {
-        std::vector<uint8_t> channel16bit;
+        std::vector<uint16_t> channel16bit;
         for (const auto& value : channel8bit) {
-            auto scaledValue = static_cast<unsigned short>(value << BITS_PER_BYTE);
-            channel16bit.push_back(static_cast<uint8_t>(scaledValue & BYTE_MASK));
-            channel16bit.push_back(static_cast<uint8_t>(scaledValue >> BITS_PER_BYTE));
+            channel16bit.push_back(static_cast<uint16_t>(value << BITS_PER_BYTE));
         }
         return channel16bit;
     };
 
-    img16bit.redChannel = convertToChannel16Bit(img16bit.redChannel);
-    img16bit.greenChannel = convertToChannel16Bit(img16bit.greenChannel);
-    img16bit.blueChannel = convertToChannel16Bit(img16bit.blueChannel);
+    img16bit.planos16 = PlanosAlineados<uint16_t>(TEST_WIDTH, TEST_HEIGHT, {
+        convertToChannel16Bit(img16bit.planos.canal(0)),
+        convertToChannel16Bit(img16bit.planos.canal(1)),
+        convertToChannel16Bit(img16bit.planos.canal(2))
+    });
+    img16bit.planos = {};
 
     setTestImage(img16bit);
     ASSERT_TRUE(writeTestImageToDisk());
@@ -238,9 +234,9 @@ TEST_F(MaxLevelSoATest, From16BitTo8Bit) {
     PPMImageSoA result;
     ASSERT_TRUE(leerImagenPPMSoA(getOutputPath(), result));
     EXPECT_EQ(result.maxValue, static_cast<int>(MAX_8BIT));
-    EXPECT_EQ(result.redChannel.size(), getTestImage().redChannel.size() / 2);
-    EXPECT_EQ(result.greenChannel.size(), getTestImage().greenChannel.size() / 2);
-    EXPECT_EQ(result.blueChannel.size(), getTestImage().blueChannel.size() / 2);
+    EXPECT_EQ(result.planos.canal(0).size(), getTestImage().planos16.canal(0).size());
+    EXPECT_EQ(result.planos.canal(1).size(), getTestImage().planos16.canal(1).size());
+    EXPECT_EQ(result.planos.canal(2).size(), getTestImage().planos16.canal(2).size());
 }
 
 // Test de comportamiento de redondeo
@@ -255,7 +251,7 @@ TEST_F(MaxLevelSoATest, RoundingBehavior) {
 
     PPMImageSoA result;
     ASSERT_TRUE(leerImagenPPMSoA(getOutputPath(), result));
-    EXPECT_EQ(result.redChannel[0], ARBITRARY_MAX);
+    EXPECT_EQ(result.planos.canal(0)[0], ARBITRARY_MAX);
 }
 
 // Verifica que se mantiene la relación de aspecto en imágenes no cuadradas
@@ -266,18 +262,20 @@ TEST_F(MaxLevelSoATest, PreserveAspectRatio) {
     rectangularImage.maxValue = static_cast<int>(MAX_8BIT);
 
     // Llenar los canales con datos de ejemplo
-    rectangularImage.redChannel = {
-        MAX_8BIT, 0, 0, MAX_8BIT,
-        0, MAX_8BIT, 0, MAX_8BIT
-    };
-    rectangularImage.greenChannel = {
-        0, MAX_8BIT, 0, 0,
-        MAX_8BIT, 0, MAX_8BIT, MAX_8BIT
-    };
-    rectangularImage.blueChannel = {
-        0, 0, MAX_8BIT, MAX_8BIT,
-        0, 0, MAX_8BIT, 0
-    };
+    rectangularImage.planos = PlanosAlineados<uint8_t>(TEST_WIDTH_RECTANGULAR, TEST_HEIGHT_RECTANGULAR, {
+        std::vector<uint8_t>{
+            MAX_8BIT, 0, 0, MAX_8BIT,
+            0, MAX_8BIT, 0, MAX_8BIT
+        },
+        std::vector<uint8_t>{
+            0, MAX_8BIT, 0, 0,
+            MAX_8BIT, 0, MAX_8BIT, MAX_8BIT
+        },
+        std::vector<uint8_t>{
+            0, 0, MAX_8BIT, MAX_8BIT,
+            0, 0, MAX_8BIT, 0
+        }
+    });
 
     ASSERT_TRUE(escribirImagenPPMSoA(getInputPath(), rectangularImage));
 
@@ -301,9 +299,9 @@ TEST_F(MaxLevelSoATest, HandleSinglePixelImage) {
     singlePixel.height = 1;
     singlePixel.maxValue = static_cast<int>(MAX_8BIT);
 
-    singlePixel.redChannel = {MAX_8BIT};
-    singlePixel.greenChannel = {MAX_8BIT};
-    singlePixel.blueChannel = {MAX_8BIT};
+    singlePixel.planos = PlanosAlineados<uint8_t>(1, 1, {
+        std::vector<uint8_t>{MAX_8BIT}, std::vector<uint8_t>{MAX_8BIT}, std::vector<uint8_t>{MAX_8BIT}
+    });
 
     setTestImage(singlePixel);
     ASSERT_TRUE(writeTestImageToDisk());
@@ -318,12 +316,12 @@ TEST_F(MaxLevelSoATest, HandleSinglePixelImage) {
     ASSERT_TRUE(leerImagenPPMSoA(getOutputPath(), result));
     EXPECT_EQ(result.width, 1);
     EXPECT_EQ(result.height, 1);
-    EXPECT_EQ(result.redChannel.size(), 1);
-    EXPECT_EQ(result.greenChannel.size(), 1);
-    EXPECT_EQ(result.blueChannel.size(), 1);
-    EXPECT_EQ(result.redChannel[0], HALF_8BIT);
-    EXPECT_EQ(result.greenChannel[0], HALF_8BIT);
-    EXPECT_EQ(result.blueChannel[0], HALF_8BIT);
+    EXPECT_EQ(result.planos.canal(0).size(), 1);
+    EXPECT_EQ(result.planos.canal(1).size(), 1);
+    EXPECT_EQ(result.planos.canal(2).size(), 1);
+    EXPECT_EQ(result.planos.canal(0)[0], HALF_8BIT);
+    EXPECT_EQ(result.planos.canal(1)[0], HALF_8BIT);
+    EXPECT_EQ(result.planos.canal(2)[0], HALF_8BIT);
 }
 
 // Test de error de escritura
@@ -344,9 +342,7 @@ TEST_F(MaxLevelSoATest, PreserveBlackPixels) {
     blackImage.width = 2;
     blackImage.height = 2;
     blackImage.maxValue = static_cast<int>(MAX_8BIT);
-    blackImage.redChannel = std::vector<uint8_t>(4, 0);
-    blackImage.greenChannel = std::vector<uint8_t>(4, 0);
-    blackImage.blueChannel = std::vector<uint8_t>(4, 0);
+    blackImage.planos = PlanosAlineados<uint8_t>(2, 2);
 
     setTestImage(blackImage);
     ASSERT_TRUE(writeTestImageToDisk());
@@ -361,15 +357,40 @@ TEST_F(MaxLevelSoATest, PreserveBlackPixels) {
     ASSERT_TRUE(leerImagenPPMSoA(getOutputPath(), result));
 
     // Verificar que todos los canales mantienen sus píxeles negros
-    for (const auto& value : result.redChannel) {
+    for (const auto& value : result.planos.canal(0)) {
         EXPECT_EQ(value, 0);
     }
-    for (const auto& value : result.greenChannel) {
+    for (const auto& value : result.planos.canal(1)) {
         EXPECT_EQ(value, 0);
     }
-    for (const auto& value : result.blueChannel) {
+    for (const auto& value : result.planos.canal(2)) {
         EXPECT_EQ(value, 0);
     }
 }
 
+// Verifica que applyMaxLevel escala en el propio búfer cuando la profundidad no cambia
+TEST_F(MaxLevelSoATest, ApplyInPlaceKeepsBuffer) {
+    PPMImageSoA image = getTestImage();
+    const uint8_t* const redData = image.planos.plano(0).data();
+
+    applyMaxLevel(image, static_cast<int>(HALF_8BIT));
+
+    EXPECT_EQ(image.maxValue, static_cast<int>(HALF_8BIT));
+    EXPECT_EQ(image.planos.plano(0).data(), redData);
+    EXPECT_EQ(image.planos.canal(0), std::vector<uint8_t>({HALF_8BIT, 0, 0, HALF_8BIT}));
+    EXPECT_EQ(image.planos.canal(2), std::vector<uint8_t>({0, 0, HALF_8BIT, HALF_8BIT}));
+}
+
+// Verifica que applyMaxLevel amplía los canales al pasar de 8 a 16 bits
+TEST_F(MaxLevelSoATest, ApplyTo16BitWidensChannels) {
+    PPMImageSoA image = getTestImage();
+
+    applyMaxLevel(image, static_cast<int>(MAX_16BIT));
+
+    EXPECT_EQ(image.maxValue, static_cast<int>(MAX_16BIT));
+    EXPECT_TRUE(image.planos.vacio());
+    ASSERT_EQ(image.planos16.canal(0).size(), getTestImage().planos.canal(0).size());
+    EXPECT_EQ(image.planos16.canal(0)[0], MAX_16BIT);
+}
+
 }  // namespace
\ No newline at end of file
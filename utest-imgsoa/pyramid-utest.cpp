@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "../imgsoa/pyramid.hpp"
+#include "../common/binario.hpp"
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  constexpr int MAX_PIXEL_VALUE = 255;
+  constexpr int IMAGE_SIZE = 4;
+  constexpr unsigned char CONST_100 = 100;
+  constexpr unsigned char CONST_200 = 200;
+
+  // Imagen de 4x4 con cuatro bloques de 2x2 de valor uniforme distinto
+  PPMImage createBlockImage() {
+    PPMImage image(PPMAttributes{.width = IMAGE_SIZE, .height = IMAGE_SIZE, .maxValue = MAX_PIXEL_VALUE});
+    for (int y = 0; y < IMAGE_SIZE; ++y) {
+      for (int x = 0; x < IMAGE_SIZE; ++x) {
+        const bool right = x >= 2;
+        const bool bottom = y >= 2;
+        const unsigned char value = right ? (bottom ? CONST_200 : CONST_100) : (bottom ? MAX_PIXEL_VALUE : 0);
+        image.pixelData.insert(image.pixelData.end(), {value, value, value});
+      }
+    }
+    return image;
+  }
+}
+
+// Cada nivel es la media de los bloques de 2x2 del anterior, hasta llegar a 1x1
+TEST(PyramidTest, GeneratesAllLevelsFromPreviousLevel) {
+  ASSERT_TRUE(escribirImagenPPM("pyramid_input.ppm", createBlockImage()));
+  performPyramidOperation("pyramid_input.ppm", "pyramid_out.ppm", 0);
+
+  PPMImage level1;
+  ASSERT_TRUE(leerImagenPPM("pyramid_out-1.ppm", level1));
+  EXPECT_EQ(level1.width, 2);
+  EXPECT_EQ(level1.height, 2);
+  const VectorReserva<uint8_t> expected1 = {0, 0, 0, CONST_100, CONST_100, CONST_100,
+                                            MAX_PIXEL_VALUE, MAX_PIXEL_VALUE, MAX_PIXEL_VALUE,
+                                            CONST_200, CONST_200, CONST_200};
+  EXPECT_EQ(level1.pixelData, expected1);
+
+  PPMImage level2;
+  ASSERT_TRUE(leerImagenPPM("pyramid_out-2.ppm", level2));
+  EXPECT_EQ(level2.width, 1);
+  EXPECT_EQ(level2.height, 1);
+  // (0 + 100 + 255 + 200) / 4 = 138.75
+  const VectorReserva<uint8_t> expected2 = {139, 139, 139};
+  EXPECT_EQ(level2.pixelData, expected2);
+  EXPECT_FALSE(std::filesystem::exists("pyramid_out-3.ppm"));
+}
+
+// Con un número de niveles solo se generan esos niveles
+TEST(PyramidTest, StopsAfterRequestedLevels) {
+  ASSERT_TRUE(escribirImagenPPM("pyramid_input.ppm", createBlockImage()));
+  std::filesystem::remove("pyramid_limited-2.ppm");
+  performPyramidOperation("pyramid_input.ppm", "pyramid_limited.ppm", 1);
+
+  EXPECT_TRUE(std::filesystem::exists("pyramid_limited-1.ppm"));
+  EXPECT_FALSE(std::filesystem::exists("pyramid_limited-2.ppm"));
+}
+
+TEST(PyramidTest, ThrowsOnNegativeLevels) {
+  EXPECT_THROW(performPyramidOperation("pyramid_input.ppm", "pyramid_out.ppm", -1), std::invalid_argument);
+}